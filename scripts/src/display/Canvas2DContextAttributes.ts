@@ -40,4 +40,20 @@ interface Canvas2DContextAttributes {
      * @default false
      */
     willReadFrequently?:boolean;
+    /**
+     * A boolean value that indicates whether the drawing commands are recorded and replayed instead of being rasterized
+     * immediately. Each time the canvas is drawn or snapshotted after new drawing, the recorded commands replace the
+     * whole content of the canvas, starting from a cleared buffer. The drawing state of the context is kept. If the
+     * commands are identical to the previous recording, the last rasterized pixels are reused. This suits layers that
+     * are redrawn every frame but rarely change.
+     * @default false
+     */
+    recording?:boolean;
+    /**
+     * A boolean value that indicates whether the drawing calls are encoded into a command buffer and submitted to the
+     * runtime in batches, which saves most of the cost of calling into the runtime for small draws. The commands are
+     * submitted at the end of each animation frame, when the buffer is full or when flush() is called.
+     * @default false
+     */
+    commandBuffer?:boolean;
 }
\ No newline at end of file
@@ -50,6 +50,171 @@ interface CanvasRenderingContext2D {
      * @default false
      */
     imageSmoothingEnabled:boolean;
+    /**
+     * Specifies the color to use inside shapes, as a CSS color string.
+     * @default "#000000"
+     */
+    fillStyle:string;
+    /**
+     * Specifies the color to use for the lines around shapes, as a CSS color string.
+     * @default "#000000"
+     */
+    strokeStyle:string;
+    /**
+     * Sets the thickness of lines in space units. Zero, negative, Infinity and NaN values are ignored.
+     * @default 1.0
+     */
+    lineWidth:number;
+    /**
+     * The current text style, as a CSS font string, e.g. "bold 12px Arial, sans-serif". The font-size and font-family
+     * values are required. Invalid values are ignored.
+     * @default "10px sans-serif"
+     */
+    font:string;
+    /**
+     * Specifies the current text alignment being used when drawing text: "start", "end", "left", "right" or "center".
+     * @default "start"
+     */
+    textAlign:string;
+    /**
+     * Specifies the current text baseline being used when drawing text: "top", "hanging", "middle", "alphabetic",
+     * "ideographic" or "bottom".
+     * @default "alphabetic"
+     */
+    textBaseline:string;
+    /**
+     * Saves the entire state of the canvas by pushing the current state onto a stack. The drawing state consists of the
+     * current transformation matrix, the clipping region, globalAlpha, globalCompositeOperation, imageSmoothingEnabled,
+     * fillStyle, strokeStyle, lineWidth, font, textAlign and textBaseline.
+     */
+    save():void;
+    /**
+     * Restores the most recently saved canvas state by popping the top entry in the drawing state stack. If there is no
+     * saved state, this method does nothing.
+     */
+    restore():void;
+    /**
+     * Adds a translation transformation by moving the canvas and its origin x horizontally and y vertically on the grid.
+     * @param x Distance to move in the horizontal direction.
+     * @param y Distance to move in the vertical direction.
+     */
+    translate(x:number, y:number):void;
+    /**
+     * Adds a rotation to the transformation matrix.
+     * @param angle The clockwise rotation angle in radians.
+     */
+    rotate(angle:number):void;
+    /**
+     * Adds a scaling transformation to the canvas units by x horizontally and by y vertically.
+     * @param x Scaling factor in the horizontal direction.
+     * @param y Scaling factor in the vertical direction.
+     */
+    scale(x:number, y:number):void;
+    /**
+     * Multiplies the current transformation with the matrix described by the arguments of this method. The matrix is
+     * described by: [a c e] [b d f] [0 0 1].
+     * @param a Horizontal scaling.
+     * @param b Horizontal skewing.
+     * @param c Vertical skewing.
+     * @param d Vertical scaling.
+     * @param e Horizontal moving.
+     * @param f Vertical moving.
+     */
+    transform(a:number, b:number, c:number, d:number, e:number, f:number):void;
+    /**
+     * Resets the current transform to the identity matrix, and then invokes the transform() method with the same
+     * arguments.
+     * @param a Horizontal scaling.
+     * @param b Horizontal skewing.
+     * @param c Vertical skewing.
+     * @param d Vertical scaling.
+     * @param e Horizontal moving.
+     * @param f Vertical moving.
+     */
+    setTransform(a:number, b:number, c:number, d:number, e:number, f:number):void;
+    /**
+     * Resets the current transform to the identity matrix.
+     */
+    resetTransform():void;
+    /**
+     * Starts a new path by emptying the list of sub-paths. Call this method when you want to create a new path.
+     */
+    beginPath():void;
+    /**
+     * Causes the point of the pen to move back to the start of the current sub-path. If the shape has already been
+     * closed or has only one point, this function does nothing.
+     */
+    closePath():void;
+    /**
+     * Moves the starting point of a new sub-path to the (x, y) coordinates.
+     */
+    moveTo(x:number, y:number):void;
+    /**
+     * Connects the last point in the sub-path to the (x, y) coordinates with a straight line.
+     */
+    lineTo(x:number, y:number):void;
+    /**
+     * Adds a quadratic Bézier curve to the path. It requires two points. The first point is a control point and the
+     * second one is the end point.
+     */
+    quadraticCurveTo(cpx:number, cpy:number, x:number, y:number):void;
+    /**
+     * Adds a cubic Bézier curve to the path. It requires three points. The first two points are control points and
+     * the third one is the end point.
+     */
+    bezierCurveTo(cp1x:number, cp1y:number, cp2x:number, cp2y:number, x:number, y:number):void;
+    /**
+     * Adds an arc to the path which is centered at (x, y) position with radius r starting at startAngle and ending at
+     * endAngle going in the given direction by anticlockwise (defaulting to clockwise).
+     */
+    arc(x:number, y:number, radius:number, startAngle:number, endAngle:number, anticlockwise?:boolean):void;
+    /**
+     * Creates a path for a rectangle at position (x, y) with a size that is determined by width and height.
+     */
+    rect(x:number, y:number, width:number, height:number):void;
+    /**
+     * Fills the current path with the current fill style.
+     * @param fillRule The algorithm by which to determine if a point is inside a path or outside a path.
+     */
+    fill(fillRule?:CanvasFillRule):void;
+    /**
+     * Fills the given path with the current fill style.
+     * @param path A Path2D path to fill.
+     * @param fillRule The algorithm by which to determine if a point is inside a path or outside a path.
+     */
+    fill(path:Path2D, fillRule?:CanvasFillRule):void;
+    /**
+     * Strokes the current path, or the given path, with the current stroke style and line width.
+     * @param path A Path2D path to stroke.
+     */
+    stroke(path?:Path2D):void;
+    /**
+     * Turns the current path into the current clipping region. The clipping region is intersected with the previous
+     * one and it is kept by save() and restore().
+     * @param fillRule The algorithm by which to determine if a point is inside a path or outside a path.
+     */
+    clip(fillRule?:CanvasFillRule):void;
+    /**
+     * Turns the given path into the current clipping region.
+     * @param path A Path2D path to clip with.
+     * @param fillRule The algorithm by which to determine if a point is inside a path or outside a path.
+     */
+    clip(path:Path2D, fillRule?:CanvasFillRule):void;
+    /**
+     * Draws a text string at the specified coordinates, filling the string's characters with the current fillStyle.
+     * The glyphs of a string are cached, drawing the same string with the same font again is cheap.
+     * @param text The text to render using the current font, textAlign and textBaseline values.
+     * @param x The x axis of the coordinate for the text starting point.
+     * @param y The y axis of the coordinate for the text starting point.
+     * @param maxWidth The maximum width to draw. If specified and the string is computed to be wider than this width,
+     * the text is condensed horizontally to fit.
+     */
+    fillText(text:string, x:number, y:number, maxWidth?:number):void;
+    /**
+     * Returns a TextMetrics object that contains information about the measured text (such as its width for example).
+     * @param text The text to measure.
+     */
+    measureText(text:string):TextMetrics;
     /**
      * Draws an image onto the canvas.
      * @param image An image to draw into the context.
@@ -86,4 +251,59 @@ interface CanvasRenderingContext2D {
      */
     drawImage(image:CanvasImageSource, sourceX:number, sourceY:number, sourceWidth:number, sourceHeight:number,
               targetX:number, targetY:number, targetWidth:number, targetHeight:number):void;
+    /**
+     * Draws a batch of sprites from one image onto the canvas in a single call. This is much faster than calling
+     * drawImage() once per sprite.
+     * @param image An image to draw into the context, typically a texture atlas.
+     * @param transforms Four values per sprite: (scos, ssin, tx, ty). The sprite is rotated and scaled by the matrix
+     * [scos, -ssin, tx; ssin, scos, ty], that is, scos = scale * cos(rotation) and ssin = scale * sin(rotation), and its
+     * top-left corner is placed at (tx, ty).
+     * @param sourceRects Four values per sprite: (x, y, width, height), the sub-rectangle of the image to draw.
+     * @param colors Optional 0xAARRGGBB colors, one per sprite, which are multiplied with the sprite pixels.
+     */
+    drawImageBatch(image:CanvasImageSource, transforms:Float32Array, sourceRects:Float32Array,
+                   colors?:Uint32Array):void;
+    /**
+     * Returns an ImageData object representing the underlying pixel data for the area of the canvas denoted by the
+     * rectangle which starts at (sx, sy) and has a width of sw and a height of sh. The pixels outside of the canvas are
+     * returned as transparent black. For contexts created with the 'willReadFrequently' attribute, the pixels are read
+     * directly from the memory of the canvas.
+     * @param sx The x coordinate of the upper left corner of the rectangle from which the ImageData will be extracted.
+     * @param sy The y coordinate of the upper left corner of the rectangle from which the ImageData will be extracted.
+     * @param sw The width of the rectangle from which the ImageData will be extracted.
+     * @param sh The height of the rectangle from which the ImageData will be extracted.
+     * @throws IndexSizeError if sw or sh is zero, or the rectangle is too large for an ImageData.
+     */
+    getImageData(sx:number, sy:number, sw:number, sh:number):ImageData;
+    /**
+     * Paints data from the given ImageData object onto the canvas. If a dirty rectangle is provided, only the pixels
+     * from that rectangle are painted. This method is not affected by the canvas transformation matrix, the clipping
+     * region, globalAlpha and globalCompositeOperation.
+     * @param imageData An ImageData object containing the array of pixel values.
+     * @param dx Horizontal position (x-coordinate) at which to place the image data in the destination canvas.
+     * @param dy Vertical position (y-coordinate) at which to place the image data in the destination canvas.
+     * @param dirtyX Horizontal position (x-coordinate) of the top-left corner from which the image data will be
+     * extracted. Defaults to 0.
+     * @param dirtyY Vertical position (y-coordinate) of the top-left corner from which the image data will be
+     * extracted. Defaults to 0.
+     * @param dirtyWidth Width of the rectangle to be painted. Defaults to the width of the image data.
+     * @param dirtyHeight Height of the rectangle to be painted. Defaults to the height of the image data.
+     */
+    putImageData(imageData:ImageData, dx:number, dy:number, dirtyX?:number, dirtyY?:number, dirtyWidth?:number,
+                 dirtyHeight?:number):void;
+    /**
+     * Submits all the pending drawing commands to the render object. Only useful if the context was created with the
+     * 'commandBuffer' attribute, the pending commands are also submitted automatically at the end of each animation
+     * frame.
+     */
+    flush():void;
+    /**
+     * @internal
+     * Executes the commands encoded in a command buffer.
+     */
+    executeCommands(commands:Float32Array, length:number, images:CanvasImageSource[], texts:string[]):void;
+}
+
+declare let CanvasRenderingContext2D:{
+    prototype:CanvasRenderingContext2D;
 }
\ No newline at end of file
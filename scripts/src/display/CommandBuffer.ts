@@ -0,0 +1,628 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017-present, cyder.org
+//  All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in the
+//  Software without restriction, including without limitation the rights to use, copy,
+//  modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//  and to permit persons to whom the Software is furnished to do so, subject to the
+//  following conditions:
+//
+//      The above copyright notice and this permission notice shall be included in all
+//      copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED *AS IS*, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//  PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @internal
+ */
+namespace cyder {
+
+    /**
+     * @internal
+     * The command types of an encoded command buffer.
+     * Note: Keep in sync with src/modules/canvas2d/CanvasCommand.h.
+     */
+    export const enum CommandType {
+        DRAW_IMAGE = 1,
+        DRAW_IMAGE_RECT = 2,
+        DRAW_IMAGE_SUB_RECT = 3,
+        SAVE = 4,
+        RESTORE = 5,
+        TRANSLATE = 6,
+        ROTATE = 7,
+        SCALE = 8,
+        TRANSFORM = 9,
+        SET_TRANSFORM = 10,
+        RESET_TRANSFORM = 11,
+        SET_GLOBAL_ALPHA = 12,
+        SET_GLOBAL_COMPOSITE_OPERATION = 13,
+        SET_IMAGE_SMOOTHING_ENABLED = 14,
+        SET_FILL_COLOR = 15,
+        SET_STROKE_COLOR = 16,
+        SET_LINE_WIDTH = 17,
+        BEGIN_PATH = 18,
+        CLOSE_PATH = 19,
+        MOVE_TO = 20,
+        LINE_TO = 21,
+        QUADRATIC_CURVE_TO = 22,
+        BEZIER_CURVE_TO = 23,
+        ARC = 24,
+        RECT = 25,
+        FILL = 26,
+        STROKE = 27,
+        CLIP = 28,
+        SET_FONT = 29,
+        SET_TEXT_ALIGN = 30,
+        SET_TEXT_BASELINE = 31,
+        FILL_TEXT = 32
+    }
+
+    /**
+     * @internal
+     * Parses a CSS color string and returns it as a 0xAARRGGBB integer, or null if the string is not a valid color.
+     */
+    export declare function parseColor(text:string):number;
+
+    /**
+     * @internal
+     * Parses a CSS font string and returns it serialized the same way as the font property of the native context, or
+     * null if the string is not a valid font.
+     */
+    export declare function parseFont(text:string):string;
+
+    /**
+     * The composite operations encoded by their indices.
+     * Note: Keep the order in sync with the composite operation table in
+     * src/modules/canvas2d/CanvasRenderingContext2D.cpp.
+     */
+    const COMPOSITE_OPERATIONS = ["source-over", "source-in", "source-out", "source-atop", "destination-over",
+        "destination-in", "destination-out", "destination-atop", "lighter", "copy", "xor", "multiply", "screen",
+        "overlay", "darken", "lighten", "color-dodge", "color-burn", "hard-light", "soft-light", "difference",
+        "exclusion", "hue", "saturation", "color", "luminosity"];
+
+    /**
+     * The text alignments and baselines encoded by their indices.
+     * Note: Keep the order in sync with the tables in src/modules/canvas2d/CanvasRenderingContext2D.cpp.
+     */
+    const TEXT_ALIGNS = ["start", "end", "left", "right", "center"];
+    const TEXT_BASELINES = ["top", "hanging", "middle", "alphabetic", "ideographic", "bottom"];
+
+    /**
+     * The parsed colors and fonts cached by their CSS strings, most of the scripts only use a handful of them. The
+     * caches are emptied once they are full, so that scripts generating new strings every frame (e.g. animated colors)
+     * do not make them grow forever.
+     */
+    const MAX_CACHE_SIZE = 256;
+
+    let colorCache:Map<string, number> = new Map<string, number>();
+
+    let fontCache:Map<string, string> = new Map<string, string>();
+
+    function parseCachedFont(text:string):string {
+        let font = fontCache.get(text);
+        if (font === undefined) {
+            font = parseFont(text);
+            if (fontCache.size >= MAX_CACHE_SIZE) {
+                fontCache.clear();
+            }
+            fontCache.set(text, font);
+        }
+        return font;
+    }
+
+    function parseCachedColor(text:string):number {
+        let color = colorCache.get(text);
+        if (color === undefined) {
+            color = parseColor(text);
+            if (colorCache.size >= MAX_CACHE_SIZE) {
+                colorCache.clear();
+            }
+            colorCache.set(text, color);
+        }
+        return color;
+    }
+
+    /**
+     * The numeric arguments of the command being encoded. They are converted before any room is reserved in the
+     * buffer, since a throwing valueOf() would otherwise leave a half written command that runs on the next flush.
+     */
+    let commandArgs:number[] = [0, 0, 0, 0, 0, 0, 0, 0];
+
+    /**
+     * Serializes a 0xAARRGGBB color the same way as the native context does.
+     */
+    function serializeColor(color:number):string {
+        let alpha = color >>> 24;
+        let red = (color >>> 16) & 0xFF;
+        let green = (color >>> 8) & 0xFF;
+        let blue = color & 0xFF;
+        if (alpha == 255) {
+            let hex = ((1 << 24) | (red << 16) | (green << 8) | blue).toString(16);
+            return "#" + hex.substr(1);
+        }
+        let a = Math.round(alpha / 255 * 1000) / 1000;
+        return "rgba(" + red + ", " + green + ", " + blue + ", " + a + ")";
+    }
+
+    function toFillRule(fillRule:string, method:string):number {
+        if (fillRule === undefined || fillRule == "nonzero") {
+            return 0;
+        }
+        if (fillRule == "evenodd") {
+            return 1;
+        }
+        throw new TypeError("Failed to execute '" + method + "' on 'CanvasRenderingContext2D': The provided value '" +
+            fillRule + "' is not a valid enum value of type CanvasFillRule.");
+    }
+
+    /**
+     * The number of floats a command buffer can hold before it is flushed automatically.
+     */
+    const BUFFER_SIZE = 16384;
+
+    let pendingBuffers:CommandBuffer[] = [];
+
+    /**
+     * @internal
+     * Executes the commands of all command buffers that have pending commands.
+     */
+    export function flushCommandBuffers():void {
+        if (pendingBuffers.length == 0) {
+            return;
+        }
+        let list = pendingBuffers;
+        pendingBuffers = [];
+        for (let buffer of list) {
+            buffer.flushFrame();
+        }
+    }
+
+    /**
+     * @internal
+     * A CommandBuffer encodes the drawing commands of a CanvasRenderingContext2D into a Float32Array and submits them
+     * to the native context in one call, instead of crossing into native code once per drawing call. The commands are
+     * submitted when the buffer is full, when flush() is called, or at the end of the current animation frame.
+     */
+    export class CommandBuffer {
+
+        public constructor(context:CanvasRenderingContext2D) {
+            this.context = context;
+        }
+
+        private context:CanvasRenderingContext2D;
+        private data:Float32Array = new Float32Array(BUFFER_SIZE);
+        private length:number = 0;
+        private images:CanvasImageSource[] = [];
+        private imageIndices:Map<CanvasImageSource, number> = new Map<CanvasImageSource, number>();
+        private texts:string[] = [];
+        private textIndices:Map<string, number> = new Map<string, number>();
+        private pending:boolean = false;
+
+        /**
+         * Submits all the pending commands to the native context.
+         */
+        public flush():void {
+            if (this.length == 0) {
+                return;
+            }
+            let length = this.length;
+            let images = this.images;
+            let texts = this.texts;
+            this.length = 0;
+            this.images = [];
+            this.imageIndices.clear();
+            this.texts = [];
+            this.textIndices.clear();
+            this.context.executeCommands(this.data, length, images, texts);
+        }
+
+        /**
+         * Submits the pending commands at the end of a frame.
+         */
+        public flushFrame():void {
+            this.pending = false;
+            this.flush();
+        }
+
+        /**
+         * Encodes a drawImage() call.
+         */
+        public drawImage(image:CanvasImageSource, args:IArguments):void {
+            let type:CommandType;
+            switch (args.length) {
+                case 3:
+                    type = CommandType.DRAW_IMAGE;
+                    break;
+                case 5:
+                    type = CommandType.DRAW_IMAGE_RECT;
+                    break;
+                case 9:
+                    type = CommandType.DRAW_IMAGE_SUB_RECT;
+                    break;
+                default:
+                    throw new TypeError("Failed to execute 'drawImage' on 'CanvasRenderingContext2D': Valid arities " +
+                        "are: [3, 5, 9], but " + args.length + " arguments provided.");
+            }
+            // Validate and convert everything that may throw first.
+            if (!image || typeof image != "object") {
+                throw new TypeError("Failed to execute 'drawImage' on 'CanvasRenderingContext2D': The provided " +
+                    "value is not of type 'CanvasImageSource'.");
+            }
+            let argCount = args.length - 1;
+            for (let i = 0; i < argCount; i++) {
+                commandArgs[i] = +args[i + 1];
+            }
+            let offset = this.reserve(argCount + 2);
+            let data = this.data;
+            data[offset] = type;
+            // Reserve before looking up the index, reserving may flush the buffer and clear the image list.
+            data[offset + 1] = this.getImageIndex(image);
+            for (let i = 0; i < argCount; i++) {
+                data[offset + i + 2] = commandArgs[i];
+            }
+        }
+
+        /**
+         * Encodes a command with the specified arguments.
+         */
+        public encode(type:CommandType, args:ArrayLike<number>, argCount:number):void {
+            for (let i = 0; i < argCount; i++) {
+                commandArgs[i] = +args[i];
+            }
+            let offset = this.reserve(argCount + 1);
+            let data = this.data;
+            data[offset] = type;
+            for (let i = 0; i < argCount; i++) {
+                data[offset + i + 1] = commandArgs[i];
+            }
+        }
+
+        /**
+         * Encodes a command whose first argument is a string.
+         */
+        public encodeText(type:CommandType, text:string, args:ArrayLike<number>, argCount:number):void {
+            for (let i = 0; i < argCount; i++) {
+                commandArgs[i] = +args[i];
+            }
+            let offset = this.reserve(argCount + 2);
+            let data = this.data;
+            data[offset] = type;
+            // Reserve before looking up the index, reserving may flush the buffer and clear the string list.
+            data[offset + 1] = this.getTextIndex(text);
+            for (let i = 0; i < argCount; i++) {
+                data[offset + i + 2] = commandArgs[i];
+            }
+        }
+
+        /**
+         * Encodes a color setter, the 32-bit color is split into two 16-bit halves so that it fits in floats exactly.
+         */
+        public encodeColor(type:CommandType, color:number):void {
+            let offset = this.reserve(3);
+            let data = this.data;
+            data[offset] = type;
+            data[offset + 1] = color >>> 16;
+            data[offset + 2] = color & 0xFFFF;
+        }
+
+        /**
+         * Reserves room for a command of the specified size and returns the offset to write it at.
+         */
+        private reserve(size:number):number {
+            if (this.length + size > BUFFER_SIZE) {
+                this.flush();
+            }
+            if (!this.pending) {
+                this.pending = true;
+                pendingBuffers.push(this);
+                invalidateFrame();
+            }
+            let offset = this.length;
+            this.length += size;
+            return offset;
+        }
+
+        private getTextIndex(text:string):number {
+            let index = this.textIndices.get(text);
+            if (index === undefined) {
+                index = this.texts.length;
+                this.texts.push(text);
+                this.textIndices.set(text, index);
+            }
+            return index;
+        }
+
+        private getImageIndex(image:CanvasImageSource):number {
+            let index = this.imageIndices.get(image);
+            if (index === undefined) {
+                index = this.images.length;
+                this.images.push(image);
+                this.imageIndices.set(image, index);
+            }
+            return index;
+        }
+    }
+
+    /**
+     * @internal
+     * Patches the getContext() method of the Canvas class to support the 'commandBuffer' context attribute, and flushes
+     * the pending commands before taking snapshots.
+     */
+    export function implementCommandBuffer(Class:Function):void {
+        let proto = Class.prototype;
+        let getContext = proto.getContext;
+        let makeImageSnapshot = proto.makeImageSnapshot;
+        proto.getContext = function (contextType:string, contextAttributes?:Canvas2DContextAttributes):any {
+            let context = getContext.apply(this, arguments);
+            if (context && contextType == "2d" && contextAttributes && contextAttributes.commandBuffer &&
+                !context.hasOwnProperty("flush")) {
+                enableCommandBuffer(context);
+            }
+            return context;
+        };
+        proto.makeImageSnapshot = function ():Image {
+            flushCommandBuffers();
+            return makeImageSnapshot.call(this);
+        };
+        CanvasRenderingContext2D.prototype.flush = function ():void {
+        };
+    }
+
+    interface DrawingState {
+        globalAlpha:number;
+        globalCompositeOperation:string;
+        imageSmoothingEnabled:boolean;
+        fillColor:number;
+        strokeColor:number;
+        lineWidth:number;
+        font:string;
+        textAlign:string;
+        textBaseline:string;
+    }
+
+    function copyState(state:DrawingState):DrawingState {
+        return {
+            globalAlpha: state.globalAlpha,
+            globalCompositeOperation: state.globalCompositeOperation,
+            imageSmoothingEnabled: state.imageSmoothingEnabled,
+            fillColor: state.fillColor,
+            strokeColor: state.strokeColor,
+            lineWidth: state.lineWidth,
+            font: state.font,
+            textAlign: state.textAlign,
+            textBaseline: state.textBaseline
+        };
+    }
+
+    function enableCommandBuffer(context:CanvasRenderingContext2D):void {
+        let buffer = new CommandBuffer(context);
+        let drawImageBatch = context.drawImageBatch;
+        let fill = context.fill;
+        let stroke = context.stroke;
+        let clip = context.clip;
+        let measureText = context.measureText;
+        let getImageData = context.getImageData;
+        let putImageData = context.putImageData;
+        // Mirror the drawing state which is readable from scripts, so that reading it does not need to flush.
+        let state:DrawingState = {
+            globalAlpha: context.globalAlpha,
+            globalCompositeOperation: context.globalCompositeOperation,
+            imageSmoothingEnabled: context.imageSmoothingEnabled,
+            fillColor: parseColor(context.fillStyle),
+            strokeColor: parseColor(context.strokeStyle),
+            lineWidth: context.lineWidth,
+            font: context.font,
+            textAlign: context.textAlign,
+            textBaseline: context.textBaseline
+        };
+        let stateStack:DrawingState[] = [];
+        Object.defineProperty(context, "globalAlpha", {
+            get: () => state.globalAlpha,
+            set: (value:number) => {
+                value = +value;
+                if (value >= 0 && value <= 1) {
+                    state.globalAlpha = value;
+                    buffer.encode(CommandType.SET_GLOBAL_ALPHA, [value], 1);
+                }
+            }
+        });
+        Object.defineProperty(context, "globalCompositeOperation", {
+            get: () => state.globalCompositeOperation,
+            set: (value:string) => {
+                let index = COMPOSITE_OPERATIONS.indexOf(value);
+                if (index != -1) {
+                    state.globalCompositeOperation = value;
+                    buffer.encode(CommandType.SET_GLOBAL_COMPOSITE_OPERATION, [index], 1);
+                }
+            }
+        });
+        Object.defineProperty(context, "imageSmoothingEnabled", {
+            get: () => state.imageSmoothingEnabled,
+            set: (value:boolean) => {
+                state.imageSmoothingEnabled = !!value;
+                buffer.encode(CommandType.SET_IMAGE_SMOOTHING_ENABLED, [value ? 1 : 0], 1);
+            }
+        });
+        Object.defineProperty(context, "fillStyle", {
+            get: () => serializeColor(state.fillColor),
+            set: (value:string) => {
+                let color = parseCachedColor(String(value));
+                if (color !== null) {
+                    state.fillColor = color;
+                    buffer.encodeColor(CommandType.SET_FILL_COLOR, color);
+                }
+            }
+        });
+        Object.defineProperty(context, "strokeStyle", {
+            get: () => serializeColor(state.strokeColor),
+            set: (value:string) => {
+                let color = parseCachedColor(String(value));
+                if (color !== null) {
+                    state.strokeColor = color;
+                    buffer.encodeColor(CommandType.SET_STROKE_COLOR, color);
+                }
+            }
+        });
+        Object.defineProperty(context, "lineWidth", {
+            get: () => state.lineWidth,
+            set: (value:number) => {
+                value = +value;
+                if (value > 0 && isFinite(value)) {
+                    state.lineWidth = value;
+                    buffer.encode(CommandType.SET_LINE_WIDTH, [value], 1);
+                }
+            }
+        });
+        Object.defineProperty(context, "font", {
+            get: () => state.font,
+            set: (value:string) => {
+                let font = parseCachedFont(String(value));
+                if (font !== null) {
+                    state.font = font;
+                    buffer.encodeText(CommandType.SET_FONT, font, [], 0);
+                }
+            }
+        });
+        Object.defineProperty(context, "textAlign", {
+            get: () => state.textAlign,
+            set: (value:string) => {
+                let index = TEXT_ALIGNS.indexOf(value);
+                if (index != -1) {
+                    state.textAlign = value;
+                    buffer.encode(CommandType.SET_TEXT_ALIGN, [index], 1);
+                }
+            }
+        });
+        Object.defineProperty(context, "textBaseline", {
+            get: () => state.textBaseline,
+            set: (value:string) => {
+                let index = TEXT_BASELINES.indexOf(value);
+                if (index != -1) {
+                    state.textBaseline = value;
+                    buffer.encode(CommandType.SET_TEXT_BASELINE, [index], 1);
+                }
+            }
+        });
+        context.save = function ():void {
+            stateStack.push(copyState(state));
+            buffer.encode(CommandType.SAVE, arguments, 0);
+        };
+        context.restore = function ():void {
+            if (stateStack.length > 0) {
+                state = stateStack.pop();
+            }
+            buffer.encode(CommandType.RESTORE, arguments, 0);
+        };
+        context.translate = function (x:number, y:number):void {
+            buffer.encode(CommandType.TRANSLATE, arguments, 2);
+        };
+        context.rotate = function (angle:number):void {
+            buffer.encode(CommandType.ROTATE, arguments, 1);
+        };
+        context.scale = function (x:number, y:number):void {
+            buffer.encode(CommandType.SCALE, arguments, 2);
+        };
+        context.transform = function (a:number, b:number, c:number, d:number, e:number, f:number):void {
+            buffer.encode(CommandType.TRANSFORM, arguments, 6);
+        };
+        context.setTransform = function (a:number, b:number, c:number, d:number, e:number, f:number):void {
+            buffer.encode(CommandType.SET_TRANSFORM, arguments, 6);
+        };
+        context.resetTransform = function ():void {
+            buffer.encode(CommandType.RESET_TRANSFORM, arguments, 0);
+        };
+        context.beginPath = function ():void {
+            buffer.encode(CommandType.BEGIN_PATH, arguments, 0);
+        };
+        context.closePath = function ():void {
+            buffer.encode(CommandType.CLOSE_PATH, arguments, 0);
+        };
+        context.moveTo = function (x:number, y:number):void {
+            buffer.encode(CommandType.MOVE_TO, arguments, 2);
+        };
+        context.lineTo = function (x:number, y:number):void {
+            buffer.encode(CommandType.LINE_TO, arguments, 2);
+        };
+        context.quadraticCurveTo = function (cpx:number, cpy:number, x:number, y:number):void {
+            buffer.encode(CommandType.QUADRATIC_CURVE_TO, arguments, 4);
+        };
+        context.bezierCurveTo = function (cp1x:number, cp1y:number, cp2x:number, cp2y:number,
+                                          x:number, y:number):void {
+            buffer.encode(CommandType.BEZIER_CURVE_TO, arguments, 6);
+        };
+        context.arc = function (x:number, y:number, radius:number, startAngle:number, endAngle:number,
+                                anticlockwise?:boolean):void {
+            if (radius < 0) {
+                throw new RangeError("Failed to execute 'arc' on 'CanvasRenderingContext2D': The radius provided (" +
+                    radius + ") is negative.");
+            }
+            buffer.encode(CommandType.ARC, [x, y, radius, startAngle, endAngle, anticlockwise ? 1 : 0], 6);
+        };
+        context.rect = function (x:number, y:number, width:number, height:number):void {
+            buffer.encode(CommandType.RECT, arguments, 4);
+        };
+        context.fill = function (path?:any, fillRule?:string):void {
+            if (path && typeof path == "object") {
+                buffer.flush();
+                fill.apply(context, arguments);
+                return;
+            }
+            buffer.encode(CommandType.FILL, [toFillRule(path, "fill")], 1);
+        };
+        context.stroke = function (path?:Path2D):void {
+            if (path) {
+                buffer.flush();
+                stroke.call(context, path);
+                return;
+            }
+            buffer.encode(CommandType.STROKE, arguments, 0);
+        };
+        context.clip = function (path?:any, fillRule?:string):void {
+            if (path && typeof path == "object") {
+                buffer.flush();
+                clip.apply(context, arguments);
+                return;
+            }
+            buffer.encode(CommandType.CLIP, [toFillRule(path, "clip")], 1);
+        };
+        context.fillText = function (text:string, x:number, y:number, maxWidth?:number):void {
+            maxWidth = maxWidth === undefined ? Infinity : maxWidth;
+            buffer.encodeText(CommandType.FILL_TEXT, String(text), [x, y, maxWidth], 3);
+        };
+        context.measureText = function (text:string):TextMetrics {
+            // The width depends on the current font, which may still be pending in the buffer.
+            buffer.flush();
+            return measureText.call(context, text);
+        };
+        context.drawImage = function (image:CanvasImageSource):void {
+            buffer.drawImage(image, arguments);
+        };
+        context.getImageData = function ():ImageData {
+            buffer.flush();
+            return getImageData.apply(context, arguments);
+        };
+        context.putImageData = function ():void {
+            buffer.flush();
+            putImageData.apply(context, arguments);
+        };
+        context.drawImageBatch = function ():void {
+            buffer.flush();
+            drawImageBatch.apply(context, arguments);
+        };
+        context.flush = function ():void {
+            buffer.flush();
+        };
+    }
+}
\ No newline at end of file
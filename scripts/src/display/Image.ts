@@ -71,6 +71,18 @@ interface Image {
      */
     encode(type?:string, quality?:number):ArrayBuffer;
 
+    /**
+     * Compresses this Image object in the same way as encode(), but on a background thread, so the encoding of a
+     * large image does not block the main thread. The pixels are captured when this method is called, disposing the
+     * image afterwards does not affect the result.
+     * @param type A string indicating the image format. The default type is "image/png".
+     * @param quality A number between 0 and 1 indicating image quality if the requested type is "image/jpeg"
+     * or "image/webp". If this argument is anything else, the default value for image quality is used.
+     * @param callback The callback function that receives the ArrayBuffer containing the encoded image, or null if the
+     * image could not be encoded. It is always invoked asynchronously.
+     */
+    encodeAsync(type:string, quality:number, callback:(data:ArrayBuffer) => void):void;
+
     /**
      * Generates an ImageData object from a rectangular region of pixel data.
      * @param x The x coordinate of the upper left corner of the rectangle from which the pixel data will be extracted.
@@ -114,6 +126,21 @@ declare let Image:{
      * @param data The ImageData to set in the Image object.
      * @param transparent Specifies whether the image supports per-pixel transparency. The default value is true.
      * Setting the transparent property to false can result in minor improvements in rendering performance.
+     * @param transferPixels Specifies whether the Image object takes over the pixel buffer of the ImageData instead of
+     * copying it. The buffer is detached from the ImageData afterwards, so its data becomes empty. The default value is
+     * false. Transferring is recommended for pixels that are generated every frame, such as procedural textures.
+     */
+    new(data:ImageData, transparent?:boolean, transferPixels?:boolean):Image;
+
+    /**
+     * Compresses a list of images on background threads, the images are encoded concurrently on all the cores.
+     * @param images The images to encode.
+     * @param type A string indicating the image format. The default type is "image/png".
+     * @param quality A number between 0 and 1 indicating image quality if the requested type is "image/jpeg"
+     * or "image/webp". If this argument is anything else, the default value for image quality is used.
+     * @param callback The callback function that receives the ArrayBuffers containing the encoded images, in the same
+     * order as the images. An element is null if the image at its index could not be encoded. It is always invoked
+     * asynchronously once all the images are encoded.
      */
-    new(data:ImageData, transparent?:boolean):Image;
+    encodeAll(images:Image[], type:string, quality:number, callback:(data:ArrayBuffer[]) => void):void;
 }
\ No newline at end of file
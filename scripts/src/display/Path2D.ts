@@ -0,0 +1,85 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017-present, cyder.org
+//  All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in the
+//  Software without restriction, including without limitation the rights to use, copy,
+//  modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//  and to permit persons to whom the Software is furnished to do so, subject to the
+//  following conditions:
+//
+//      The above copyright notice and this permission notice shall be included in all
+//      copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED *AS IS*, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//  PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+/**
+ * The CanvasFillRule type decides if a point is inside or outside a path. The "nonzero" rule is the default.
+ */
+type CanvasFillRule = "nonzero" | "evenodd";
+
+/**
+ * The Path2D interface is used to declare paths that are then later used on CanvasRenderingContext2D objects. The
+ * geometry of a Path2D object is kept natively, so a path can be built once and then filled, stroked or used as a
+ * clipping region many times without being rebuilt.
+ */
+interface Path2D {
+    /**
+     * Adds to the path the path given by the argument.
+     * @param path A Path2D path to add.
+     */
+    addPath(path:Path2D):void;
+    /**
+     * Causes the point of the pen to move back to the start of the current sub-path. If the shape has already been
+     * closed or has only one point, this function does nothing.
+     */
+    closePath():void;
+    /**
+     * Moves the starting point of a new sub-path to the (x, y) coordinates.
+     */
+    moveTo(x:number, y:number):void;
+    /**
+     * Connects the last point in the sub-path to the (x, y) coordinates with a straight line.
+     */
+    lineTo(x:number, y:number):void;
+    /**
+     * Adds a quadratic Bézier curve to the path. It requires two points. The first point is a control point and the
+     * second one is the end point.
+     */
+    quadraticCurveTo(cpx:number, cpy:number, x:number, y:number):void;
+    /**
+     * Adds a cubic Bézier curve to the path. It requires three points. The first two points are control points and
+     * the third one is the end point.
+     */
+    bezierCurveTo(cp1x:number, cp1y:number, cp2x:number, cp2y:number, x:number, y:number):void;
+    /**
+     * Adds an arc to the path which is centered at (x, y) position with radius r starting at startAngle and ending at
+     * endAngle going in the given direction by anticlockwise (defaulting to clockwise).
+     */
+    arc(x:number, y:number, radius:number, startAngle:number, endAngle:number, anticlockwise?:boolean):void;
+    /**
+     * Creates a path for a rectangle at position (x, y) with a size that is determined by width and height.
+     */
+    rect(x:number, y:number, width:number, height:number):void;
+}
+
+declare let Path2D:{
+    prototype:Path2D;
+    /**
+     * Creates a new Path2D object.
+     * @param path When invoked with another Path2D object, a copy of the path argument is created.
+     */
+    new(path?:Path2D):Path2D;
+}
@@ -30,21 +30,69 @@
 namespace cyder {
     /**
      * @internal
-     * load image from url.
+     * load image from url. The file is read and decoded on a background thread, the callback is always invoked
+     * asynchronously.
      * @param url The URL of the image to be loaded.
      * @param callback The callback function that receive the loaded image data.
      * @param thisArg The value of this provided for the call to the callback function.
+     * @param lazyDecode Whether to keep the image encoded and decode it the first time it is drawn.
+     * @param maxWidth The maximum width of the decoded image, 0 means unlimited.
+     * @param maxHeight The maximum height of the decoded image, 0 means unlimited.
+     * @param progressiveRows The number of rows decoded per slice if the image is decoded progressively, 0 means the
+     * image is decoded in one go. The callback is then invoked after each slice with the same image and complete set to
+     * false, until the last one. Returning false from the callback stops decoding.
      */
-    export declare function loadImageFromURL(url:string, callback:(data:Image) => void, thisArg:any);
+    export declare function loadImageFromURL(url:string, callback:(data:Image, complete:boolean) => boolean|void,
+                                             thisArg:any, lazyDecode?:boolean, maxWidth?:number, maxHeight?:number,
+                                             progressiveRows?:number);
 
     /**
      * @internal
-     * load image from byte array.
+     * load image from byte array. The image is decoded on a background thread, the callback is always invoked
+     * asynchronously.
      * @param bytes The byte array of image to be loaded.
      * @param callback The callback function that receive the loaded image data.
      * @param thisArg The value of this provided for the call to the callback function.
+     * @param lazyDecode Whether to keep the image encoded and decode it the first time it is drawn.
+     * @param maxWidth The maximum width of the decoded image, 0 means unlimited.
+     * @param maxHeight The maximum height of the decoded image, 0 means unlimited.
+     * @param progressiveRows The number of rows decoded per slice if the image is decoded progressively, 0 means the
+     * image is decoded in one go.
      */
-    export declare function loadImageFromBytes(bytes:ArrayBuffer, callback:(data:Image) => void, thisArg:any);
+    export declare function loadImageFromBytes(bytes:ArrayBuffer,
+                                               callback:(data:Image, complete:boolean) => boolean|void,
+                                               thisArg:any, lazyDecode?:boolean, maxWidth?:number, maxHeight?:number,
+                                               progressiveRows?:number);
+
+    /**
+     * @internal
+     * Returns the maximum number of bytes of decoded pixels held for lazily decoded images.
+     */
+    export declare function getDecodedImageBudget():number;
+
+    /**
+     * @internal
+     * Sets the maximum number of bytes of decoded pixels held for lazily decoded images.
+     */
+    export declare function setDecodedImageBudget(bytes:number):void;
+
+    /**
+     * @internal
+     * Returns the maximum total size in bytes of the images kept in the image cache.
+     */
+    export declare function getImageCacheBudget():number;
+
+    /**
+     * @internal
+     * Sets the maximum total size in bytes of the images kept in the image cache, 0 disables the cache.
+     */
+    export declare function setImageCacheBudget(bytes:number):void;
+
+    /**
+     * @internal
+     * Returns the counters of the image cache.
+     */
+    export declare function getImageCacheStats():ImageCacheStats;
 
     /**
      * @internal
@@ -55,10 +103,44 @@ namespace cyder {
      * @internal
      * The Loader class is used to load image (JPG, PNG, or GIF) files. Use the load() method to initiate loading.
      * The loaded image data is in the data property of ImageLoader.
+     * @event Event.CHANGE Emitted when more rows of an image decoded progressively are available.
      * @event Event.COMPLETE Emitted when the net request is complete.
      * @event IOErrorEvent.IO_ERROR Emitted when the net request is failed.
      */
     export class ImageLoader extends cyder.EventEmitter {
+        /**
+         * The maximum number of bytes of decoded pixels held for the images loaded with lazyDecode enabled. Once the
+         * budget is exceeded, the pixels of the least recently drawn images are discarded and decoded again when they
+         * are drawn next time.
+         */
+        public static get decodedImageBudget():number {
+            return cyder.getDecodedImageBudget();
+        }
+
+        public static set decodedImageBudget(value:number) {
+            cyder.setDecodedImageBudget(value);
+        }
+
+        /**
+         * The maximum total size in bytes of the images kept in the image cache. Loading the same file, or the same
+         * bytes, again returns the cached image instead of decoding another copy of it. Set it to 0 to disable the
+         * cache.
+         */
+        public static get cacheBudget():number {
+            return cyder.getImageCacheBudget();
+        }
+
+        public static set cacheBudget(value:number) {
+            cyder.setImageCacheBudget(value);
+        }
+
+        /**
+         * Returns the hit and miss counters and the current size of the image cache.
+         */
+        public static getCacheStats():ImageCacheStats {
+            return cyder.getImageCacheStats();
+        }
+
         /**
          * Creates a ImageLoader instance.
          */
@@ -71,32 +153,82 @@ namespace cyder {
          */
         public data:Image = null;
 
+        /**
+         * Whether to keep the loaded images encoded and decode them on demand the first time they are drawn. This
+         * saves the memory of the images that are loaded but not drawn, at the cost of decoding on the main thread
+         * while drawing. The default value is false.
+         */
+        public lazyDecode:boolean = false;
+
+        /**
+         * The number of rows to decode at a time if the images are decoded progressively, the default value is 0, which
+         * means the images are decoded in one go. Decoding progressively shows the rows of a very large image as they
+         * are decoded, the data property is set and Event.CHANGE is emitted after each slice of rows, then
+         * Event.COMPLETE is emitted once the last row is decoded. Images loaded with lazyDecode enabled or a maximum
+         * size are never decoded progressively.
+         */
+        public progressiveRows:number = 0;
+
         /**
          * @private
          */
         private currentURL:string;
 
         /**
-         * start a load operation。<br/>
+         * @private
+         * Identifies the current load operation, the results of the aborted ones are ignored.
+         */
+        private loadID:number = 0;
+
+        /**
+         * start a load operation。The image is loaded asynchronously, Event.COMPLETE is emitted once it is decoded.<br/>
          * Note: Calling this method for an already active request (one for which load() has already been called) will abort
          * the last load operation immediately.
          * @param url The URL of the image to be loaded.
+         * @param options The options to decode the image with.
          */
-        public load(url:string):void {
+        public load(url:string, options?:ImageLoadOptions):void {
             this.currentURL = url;
-            cyder.loadImageFromURL(url, this.onLoadFinish, this);
+            let loadID = ++this.loadID;
+            cyder.loadImageFromURL(url, (data:Image, complete:boolean) => {
+                return this.onLoadResult(loadID, data, complete);
+            }, this, this.lazyDecode, options ? options.maxWidth : 0, options ? options.maxHeight : 0,
+                this.progressiveRows);
         }
 
         /**
          * Loads image from binary data stored in a ArrayBuffer object.
          * @param bytes The binary data of the image to be loaded.
+         * @param options The options to decode the image with.
          */
-        public loadBytes(bytes:ArrayBuffer):void {
+        public loadBytes(bytes:ArrayBuffer, options?:ImageLoadOptions):void {
             this.currentURL = "";
             if (bytes.byteLength == 0) {
                 throw new Error("The ArrayBuffer parameter in ImageLoader.loadBytes() must have length greater than 0.");
             }
-            cyder.loadImageFromBytes(bytes, this.onLoadFinish, this);
+            let loadID = ++this.loadID;
+            cyder.loadImageFromBytes(bytes, (data:Image, complete:boolean) => {
+                return this.onLoadResult(loadID, data, complete);
+            }, this, this.lazyDecode, options ? options.maxWidth : 0, options ? options.maxHeight : 0,
+                this.progressiveRows);
+        }
+
+        /**
+         * @private
+         * Returns false to stop decoding the image of an aborted load.
+         */
+        private onLoadResult(loadID:number, data:Image, complete:boolean):boolean {
+            if (loadID != this.loadID) {
+                return false;
+            }
+            if (complete) {
+                this.onLoadFinish(data);
+            }
+            else {
+                this.data = data;
+                this.emitWith(Event.CHANGE);
+            }
+            return true;
         }
 
         /**
@@ -125,9 +257,49 @@ namespace cyder {
 }
 
 
+/**
+ * The options to decode an image loaded by ImageLoader with.
+ */
+interface ImageLoadOptions {
+    /**
+     * The maximum width of the decoded image. An image larger than the maximum size is downsampled while decoding, by
+     * the smallest integer factor that fits it in, e.g. a 4000×3000 JPEG with a maxWidth of 500 is decoded to 500×375.
+     * It is much faster and uses less memory than decoding the image in full size and drawing it scaled down. A
+     * downsampled image is always decoded immediately, regardless of lazyDecode. The default value is 0 (unlimited).
+     */
+    maxWidth?:number;
+    /**
+     * The maximum height of the decoded image. The default value is 0 (unlimited).
+     */
+    maxHeight?:number;
+}
+
+/**
+ * The counters of the image cache shared by all the ImageLoader instances.
+ */
+interface ImageCacheStats {
+    /**
+     * The number of loads that returned a cached image.
+     */
+    hits:number;
+    /**
+     * The number of loads that had to decode the image.
+     */
+    misses:number;
+    /**
+     * The number of images in the cache.
+     */
+    count:number;
+    /**
+     * The total size in bytes of the images in the cache.
+     */
+    bytes:number;
+}
+
 /**
  * The Loader class is used to load image (JPG, PNG, or GIF) files. Use the load() method to initiate loading.
  * The loaded image data is in the data property of ImageLoader.
+ * @event Event.CHANGE Emitted when more rows of an image decoded progressively are available.
  * @event Event.COMPLETE Emitted when the net request is complete.
  * @event IOErrorEvent.IO_ERROR Emitted when the net request is failed.
  */
@@ -138,18 +310,36 @@ interface ImageLoader extends EventEmitter {
     data:Image;
 
     /**
-     * start a load operation。<br/>
+     * Whether to keep the loaded images encoded and decode them on demand the first time they are drawn. This saves
+     * the memory of the images that are loaded but not drawn, at the cost of decoding on the main thread while drawing.
+     * The default value is false.
+     */
+    lazyDecode:boolean;
+
+    /**
+     * The number of rows to decode at a time if the images are decoded progressively, the default value is 0, which
+     * means the images are decoded in one go. Decoding progressively shows the rows of a very large image as they are
+     * decoded, the data property is set and Event.CHANGE is emitted after each slice of rows, then Event.COMPLETE is
+     * emitted once the last row is decoded. Images loaded with lazyDecode enabled or a maximum size are never decoded
+     * progressively.
+     */
+    progressiveRows:number;
+
+    /**
+     * start a load operation。The image is loaded asynchronously, Event.COMPLETE is emitted once it is decoded.<br/>
      * Note: Calling this method for an already active request (one for which load() has already been called) will abort
      * the last load operation immediately.
      * @param url The URL of the image to be loaded.
+     * @param options The options to decode the image with.
      */
-    load(url:string):void;
+    load(url:string, options?:ImageLoadOptions):void;
 
     /**
      * Loads image from binary data stored in a ArrayBuffer object.
      * @param bytes The binary data of the image to be loaded.
+     * @param options The options to decode the image with.
      */
-    loadBytes(bytes:ArrayBuffer):void;
+    loadBytes(bytes:ArrayBuffer, options?:ImageLoadOptions):void;
 }
 
 let ImageLoader:{
@@ -157,6 +347,24 @@ let ImageLoader:{
      * Creates a ImageLoader instance.
      */
     new():ImageLoader;
+
+    /**
+     * The maximum number of bytes of decoded pixels held for the images loaded with lazyDecode enabled. Once the
+     * budget is exceeded, the pixels of the least recently drawn images are discarded and decoded again when they are
+     * drawn next time.
+     */
+    decodedImageBudget:number;
+
+    /**
+     * The maximum total size in bytes of the images kept in the image cache. Loading the same file, or the same bytes,
+     * again returns the cached image instead of decoding another copy of it. Set it to 0 to disable the cache.
+     */
+    cacheBudget:number;
+
+    /**
+     * Returns the hit and miss counters and the current size of the image cache.
+     */
+    getCacheStats():ImageCacheStats;
 };
 
 ImageLoader = cyder.ImageLoader;
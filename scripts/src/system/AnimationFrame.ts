@@ -31,18 +31,35 @@ namespace cyder {
 
     let callbackList:FrameRequestCallback[] = [];
     let requested = false;
+    let updating = false;
 
     export declare function requestFrame():void;
 
     export function updateFrame(timestamp:number):void {
         requested = false;
-        if (callbackList.length == 0) {
-            return;
+        if (callbackList.length > 0) {
+            let list = callbackList;
+            callbackList = [];
+            updating = true;
+            try {
+                for (let callback of list) {
+                    callback(timestamp);
+                }
+            } finally {
+                updating = false;
+            }
         }
-        let list = callbackList;
-        callbackList = [];
-        for (let callback of list) {
-            callback(timestamp);
+        flushCommandBuffers();
+    }
+
+    /**
+     * Requests a frame update so that the pending drawing commands get submitted, unless a frame is being updated,
+     * which submits them at its end anyway.
+     */
+    export function invalidateFrame():void {
+        if (!requested && !updating) {
+            requested = true;
+            cyder.requestFrame();
         }
     }
 
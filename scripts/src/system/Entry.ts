@@ -40,6 +40,7 @@ namespace cyder {
         }
         initialized = true;
         implementEventEmitter(NativeWindow);
+        implementCommandBuffer(Canvas);
         global.console = new Console(nativeApplication.standardOutput, nativeApplication.standardError);
     }
 } 
\ No newline at end of file
@@ -34,4 +34,44 @@ interface Performance {
      * thousandths of a millisecond (5 microseconds).
      */
     now():number;
+
+    /**
+     * Returns the counters of the allocator of the ArrayBuffer backing stores, including the buffers of all the
+     * typed arrays and ImageData objects.
+     */
+    getArrayBufferStats():ArrayBufferStats;
+}
+
+/**
+ * The counters of the allocator of the ArrayBuffer backing stores.
+ */
+interface ArrayBufferStats {
+    /**
+     * The total size in bytes of the live array buffers.
+     */
+    liveBytes:number;
+    /**
+     * The highest value that liveBytes has reached.
+     */
+    peakBytes:number;
+    /**
+     * The number of live array buffers.
+     */
+    liveCount:number;
+    /**
+     * The total number of array buffers allocated.
+     */
+    allocationCount:number;
+    /**
+     * The number of allocations that reused the memory of a freed array buffer.
+     */
+    reuseCount:number;
+    /**
+     * The total size in bytes of the freed large blocks kept for reuse.
+     */
+    pooledBytes:number;
+    /**
+     * The total size in bytes of the slabs the small array buffers are carved out of, they are never released.
+     */
+    slabBytes:number;
 }
\ No newline at end of file
@@ -26,8 +26,12 @@
 
 
 #include <platform/Application.h>
+#include <platform/FileData.h>
 #include <libplatform.h>
+#include <cstring>
+#include <fstream>
 #include "base/Globals.h"
+#include "binding/ArrayBufferAllocator.h"
 #include "binding/Environment.h"
 #include "binding/JSMain.h"
 #include "binding/DebugAgent.h"
@@ -36,17 +40,97 @@
 
 namespace cyder {
 
-    class ArrayBufferAllocator : public v8::ArrayBuffer::Allocator {
-    public:
-        virtual void* Allocate(size_t length) {
-            void* data = AllocateUninitialized(length);
-            return data == nullptr ? data : memset(data, 0, length);
-        }
+    static const char* SNAPSHOT_FILE = "cyder_snapshot.bin";
+
+#ifndef CYDER_BUILD_ID
+#define CYDER_BUILD_ID __DATE__ " " __TIME__
+#endif
 
-        virtual void* AllocateUninitialized(size_t length) { return malloc(length); }
+    /**
+     * The size of the header written before the startup snapshot, it keeps the snapshot data aligned.
+     */
+    static const size_t SNAPSHOT_HEADER_SIZE = 64;
 
-        virtual void Free(void* data, size_t) { free(data); }
-    };
+    /**
+     * Writes the header identifying the build that made a startup snapshot. v8 aborts on a snapshot made by another
+     * version of it, so a snapshot is only used by the same version and build.
+     */
+    static void MakeSnapshotHeader(char header[SNAPSHOT_HEADER_SIZE]) {
+        memset(header, 0, SNAPSHOT_HEADER_SIZE);
+        snprintf(header, SNAPSHOT_HEADER_SIZE, "cyder %s %s", v8::V8::GetVersion(), CYDER_BUILD_ID);
+    }
+
+    /**
+     * Evaluates the runtime script in a new context and writes a startup snapshot of the context to outputPath. Only
+     * the javascript heap is baked in, the native templates are still installed at startup, they hold pointers to the
+     * Environment that only exist at runtime.
+     */
+    static int MakeSnapshot(const std::string& scriptPath, const std::string& outputPath) {
+        std::ifstream in(scriptPath);
+        std::istreambuf_iterator<char> beg(in), end;
+        std::string jsText(beg, end);
+        v8::StartupData blob = {nullptr, 0};
+        {
+            v8::SnapshotCreator creator;
+            auto isolate = creator.GetIsolate();
+            {
+                v8::HandleScope scope(isolate);
+                auto context = v8::Context::New(isolate);
+                v8::Context::Scope contextScope(context);
+                v8::TryCatch tryCatch(isolate);
+                auto source = v8::String::NewFromUtf8(isolate, jsText.c_str(), v8::NewStringType::kNormal,
+                                                      static_cast<int>(jsText.size())).ToLocalChecked();
+                v8::ScriptOrigin origin(v8::String::NewFromUtf8(isolate, scriptPath.c_str()));
+                auto script = v8::Script::Compile(context, source, &origin);
+                if (script.IsEmpty() || script.ToLocalChecked()->Run(context).IsEmpty()) {
+                    v8::String::Utf8Value error(tryCatch.Exception());
+                    fprintf(stderr, "Failed to evaluate %s: %s\n", scriptPath.c_str(), *error ? *error : "");
+                    return 1;
+                }
+                // The first context added to the snapshot is the one that v8::Context::New() deserializes.
+                creator.AddContext(context);
+            }
+            // Keep the compiled code of the functions that ran, so they are not compiled again at startup.
+            blob = creator.CreateBlob(v8::SnapshotCreator::FunctionCodeHandling::kKeep);
+        }
+        if (blob.data == nullptr) {
+            fprintf(stderr, "Failed to create the startup snapshot.\n");
+            return 1;
+        }
+        char header[SNAPSHOT_HEADER_SIZE];
+        MakeSnapshotHeader(header);
+        std::ofstream out(outputPath, std::ios::binary);
+        out.write(header, SNAPSHOT_HEADER_SIZE);
+        out.write(blob.data, blob.raw_size);
+        delete[] blob.data;
+        return out.good() ? 0 : 1;
+    }
+
+    /**
+     * Returns the startup snapshot made by MakeSnapshot() without its header, or nullptr if there is none, it is older
+     * than the runtime script (e.g. the script was rebuilt without rebuilding the snapshot), or it was made by another
+     * build of cyder.
+     */
+    static sk_sp<SkData> ReadSnapshot(const std::string& snapshotPath, const std::string& scriptPath) {
+        int64_t snapshotTime = 0;
+        int64_t scriptTime = 0;
+        size_t size = 0;
+        if (!FileData::GetFileInfo(snapshotPath, &snapshotTime, &size) ||
+            !FileData::GetFileInfo(scriptPath, &scriptTime, &size) || snapshotTime < scriptTime) {
+            return nullptr;
+        }
+        auto data = FileData::MapFile(snapshotPath);
+        if (!data || data->size() <= SNAPSHOT_HEADER_SIZE) {
+            return nullptr;
+        }
+        char header[SNAPSHOT_HEADER_SIZE];
+        MakeSnapshotHeader(header);
+        if (memcmp(data->data(), header, SNAPSHOT_HEADER_SIZE) != 0) {
+            fprintf(stderr, "Ignoring %s, it was made by another build of cyder.\n", snapshotPath.c_str());
+            return nullptr;
+        }
+        return SkData::MakeSubset(data.get(), SNAPSHOT_HEADER_SIZE, data->size() - SNAPSHOT_HEADER_SIZE);
+    }
 
 
     int Start(int argc, char* argv[]) {
@@ -59,10 +143,30 @@ namespace cyder {
         v8::V8::InitializePlatform(platform);
         v8::V8::Initialize();
 
+        std::string arg = argc > 1 ? argv[1] : "";
+        bool waitForConnection = (arg == "--debug-brk");
+        bool debug = (arg == "--debug" || waitForConnection);
+        auto scriptPath = Globals::resolvePath("cyder.js");
+        if (arg == "--make-snapshot") {
+            auto result = MakeSnapshot(scriptPath, argc > 2 ? argv[2] : Globals::resolvePath(SNAPSHOT_FILE));
+            v8::V8::Dispose();
+            v8::V8::ShutdownPlatform();
+            delete platform;
+            return result;
+        }
+
         // Create a new Isolate and make it the current one.
-        auto allocator = new ArrayBufferAllocator();
         v8::Isolate::CreateParams create_params;
-        create_params.array_buffer_allocator = allocator;
+        create_params.array_buffer_allocator = ArrayBufferAllocator::GetInstance();
+        // With the startup snapshot, the new context already contains everything the runtime script defines. The
+        // debugger needs the script to be compiled from its source, so the snapshot is skipped when debugging.
+        auto snapshot = debug ? nullptr : ReadSnapshot(Globals::resolvePath(SNAPSHOT_FILE), scriptPath);
+        v8::StartupData snapshotBlob = {nullptr, 0};
+        if (snapshot) {
+            snapshotBlob.data = static_cast<const char*>(snapshot->data());
+            snapshotBlob.raw_size = static_cast<int>(snapshot->size());
+            create_params.snapshot_blob = &snapshotBlob;
+        }
         auto isolate = v8::Isolate::New(create_params);
         v8::Isolate::Scope isolateScope(isolate);
         PerIsolateData isolateData(isolate);
@@ -72,15 +176,13 @@ namespace cyder {
         v8::Context::Scope contextScope(context);
         ScriptState scriptState(context);
         // Enable javascript debug agent.
-        std::string arg = argc > 1 ? argv[1] : "";
-        bool waitForConnection = (arg == "--debug-brk");
-        if (arg == "--debug" || waitForConnection) {
+        if (debug) {
             //DebugAgent::Initialize(Globals::applicationDirectory);
             DebugAgent::Enable("Cyder", 5959, waitForConnection);
         }
 
         Environment environment(context);
-        JSMain jsMain(Globals::resolvePath("cyder.js"), &environment);
+        JSMain jsMain(snapshot ? "" : scriptPath, &environment);
         jsMain.start(argc, argv);
         auto result = environment.executeScript(Globals::resolvePath("test.js"));
         ASSERT(!result.IsEmpty());
@@ -91,7 +193,6 @@ namespace cyder {
         v8::V8::Dispose();
         v8::V8::ShutdownPlatform();
         delete platform;
-        delete allocator;
         return 0;
     }
 
@@ -0,0 +1,92 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017-present, cyder.org
+//  All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in the
+//  Software without restriction, including without limitation the rights to use, copy,
+//  modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//  and to permit persons to whom the Software is furnished to do so, subject to the
+//  following conditions:
+//
+//      The above copyright notice and this permission notice shall be included in all
+//      copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED *AS IS*, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//  PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "ThreadPool.h"
+#include "platform/Application.h"
+#include <algorithm>
+
+namespace cyder {
+
+    int ThreadPool::pendingReplyCount = 0;
+
+    ThreadPool* ThreadPool::Default() {
+        static ThreadPool* threadPool = new ThreadPool(
+                std::max(1, static_cast<int>(std::thread::hardware_concurrency())));
+        return threadPool;
+    }
+
+    ThreadPool::ThreadPool(int threadCount) {
+        for (int i = 0; i < threadCount; i++) {
+            threads.push_back(std::thread(&ThreadPool::runWorker, this));
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+            queue.clear();
+        }
+        condition.notify_all();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    void ThreadPool::post(const std::function<void()>& work, const std::function<void()>& reply) {
+        pendingReplyCount++;
+        auto task = [work, reply]() {
+            work();
+            Application::application->postTask([reply]() {
+                pendingReplyCount--;
+                reply();
+            });
+        };
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.push_back(task);
+        }
+        condition.notify_one();
+    }
+
+    void ThreadPool::runWorker() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                condition.wait(lock, [this]() { return stopping || !queue.empty(); });
+                if (stopping) {
+                    return;
+                }
+                task = queue.front();
+                queue.pop_front();
+            }
+            task();
+        }
+    }
+
+}  // namespace cyder
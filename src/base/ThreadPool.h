@@ -0,0 +1,87 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017-present, cyder.org
+//  All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in the
+//  Software without restriction, including without limitation the rights to use, copy,
+//  modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//  and to permit persons to whom the Software is furnished to do so, subject to the
+//  following conditions:
+//
+//      The above copyright notice and this permission notice shall be included in all
+//      copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED *AS IS*, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//  PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef CYDER_THREADPOOL_H
+#define CYDER_THREADPOOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cyder {
+
+    /**
+     * A fixed set of worker threads that run blocking work, such as file reads and image decoding, off the main thread.
+     */
+    class ThreadPool {
+    public:
+        /**
+         * Returns the thread pool shared by the whole application, which has one thread per CPU core.
+         */
+        static ThreadPool* Default();
+
+        /**
+         * Returns the number of replies posted with ThreadPool::post() that have not run yet, for all the thread pools.
+         * The main loop keeps running while it is not zero. Only called on the main thread.
+         */
+        static int PendingReplyCount() {
+            return pendingReplyCount;
+        }
+
+        explicit ThreadPool(int threadCount);
+
+        /**
+         * Waits for the work that is already running, discards the queued work and joins the threads.
+         */
+        ~ThreadPool();
+
+        /**
+         * Runs work on one of the threads of the pool, then runs reply on the main thread once work is done. It must be
+         * called on the main thread.
+         * @param work The function to run on a thread of the pool.
+         * @param reply The function to run on the main thread after work has returned.
+         */
+        void post(const std::function<void()>& work, const std::function<void()>& reply);
+
+    private:
+        static int pendingReplyCount;
+
+        std::vector<std::thread> threads;
+        std::deque<std::function<void()>> queue;
+        std::mutex mutex;
+        std::condition_variable condition;
+        bool stopping = false;
+
+        void runWorker();
+    };
+
+}  // namespace cyder
+
+#endif //CYDER_THREADPOOL_H
@@ -0,0 +1,190 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017-present, cyder.org
+//  All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in the
+//  Software without restriction, including without limitation the rights to use, copy,
+//  modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//  and to permit persons to whom the Software is furnished to do so, subject to the
+//  following conditions:
+//
+//      The above copyright notice and this permission notice shall be included in all
+//      copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED *AS IS*, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//  PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "ArrayBufferAllocator.h"
+#include <cstdlib>
+#include <cstring>
+
+namespace cyder {
+
+    static const size_t MIN_BLOCK_SIZE = 16;
+    static const size_t MAX_SMALL_SIZE = 4096;
+    /**
+     * The size of the slabs that the small blocks are carved out of. They are never returned to the system, a free block
+     * is only reused by the same size class.
+     */
+    static const size_t SLAB_SIZE = 64 * 1024;
+    /**
+     * Large blocks are rounded up to a multiple of the page size, so buffers of nearly the same size share blocks.
+     */
+    static const size_t PAGE_SIZE = 4096;
+    /**
+     * The maximum total size of the freed large blocks kept for reuse, enough for a few full screen pixel buffers.
+     */
+    static const size_t MAX_POOLED_BYTES = 64 * 1024 * 1024;
+
+    static int SizeClassOf(size_t length) {
+        int sizeClass = 0;
+        size_t size = MIN_BLOCK_SIZE;
+        while (size < length) {
+            size <<= 1;
+            sizeClass++;
+        }
+        return sizeClass;
+    }
+
+    static size_t LargeBlockSize(size_t length) {
+        return (length + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1);
+    }
+
+    ArrayBufferAllocator* ArrayBufferAllocator::GetInstance() {
+        static ArrayBufferAllocator* instance = new ArrayBufferAllocator();
+        return instance;
+    }
+
+    ArrayBufferAllocator::ArrayBufferAllocator() {
+        memset(freeBlocks, 0, sizeof(freeBlocks));
+    }
+
+    void* ArrayBufferAllocator::Allocate(size_t length) {
+        return allocate(length, true);
+    }
+
+    void* ArrayBufferAllocator::AllocateUninitialized(size_t length) {
+        return allocate(length, false);
+    }
+
+    void* ArrayBufferAllocator::allocate(size_t length, bool zeroed) {
+        std::lock_guard<std::mutex> lock(mutex);
+        void* data;
+        if (length <= MAX_SMALL_SIZE) {
+            data = allocateSmall(SizeClassOf(length));
+            if (data && zeroed) {
+                memset(data, 0, length);
+            }
+        } else {
+            data = allocateLarge(LargeBlockSize(length), zeroed);
+        }
+        if (!data) {
+            return nullptr;
+        }
+        _stats.allocationCount++;
+        _stats.liveCount++;
+        _stats.liveBytes += length;
+        if (_stats.liveBytes > _stats.peakBytes) {
+            _stats.peakBytes = _stats.liveBytes;
+        }
+        return data;
+    }
+
+    void* ArrayBufferAllocator::allocateSmall(int sizeClass) {
+        auto block = freeBlocks[sizeClass];
+        if (block) {
+            freeBlocks[sizeClass] = *reinterpret_cast<void**>(block);
+            _stats.reuseCount++;
+            return block;
+        }
+        auto blockSize = MIN_BLOCK_SIZE << sizeClass;
+        auto slab = static_cast<char*>(malloc(SLAB_SIZE));
+        if (!slab) {
+            return nullptr;
+        }
+        _stats.slabBytes += SLAB_SIZE;
+        // Return the first block of the new slab and link the others in address order.
+        for (size_t offset = SLAB_SIZE - blockSize; offset > 0; offset -= blockSize) {
+            auto next = slab + offset;
+            *reinterpret_cast<void**>(next) = freeBlocks[sizeClass];
+            freeBlocks[sizeClass] = next;
+        }
+        return slab;
+    }
+
+    void* ArrayBufferAllocator::allocateLarge(size_t size, bool zeroed) {
+        auto pooled = freeLargeBlocks.find(size);
+        if (pooled != freeLargeBlocks.end() && !pooled->second.empty()) {
+            auto data = pooled->second.back();
+            pooled->second.pop_back();
+            _stats.pooledBytes -= size;
+            _stats.reuseCount++;
+            if (zeroed) {
+                memset(data, 0, size);
+            }
+            return data;
+        }
+        // calloc() gets zeroed pages from the system without touching them.
+        return zeroed ? calloc(1, size) : malloc(size);
+    }
+
+    void ArrayBufferAllocator::Free(void* data, size_t length) {
+        if (!data) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        _stats.liveCount--;
+        _stats.liveBytes -= length;
+        if (length <= MAX_SMALL_SIZE) {
+            auto sizeClass = SizeClassOf(length);
+            *reinterpret_cast<void**>(data) = freeBlocks[sizeClass];
+            freeBlocks[sizeClass] = data;
+        } else {
+            freeLarge(data, LargeBlockSize(length));
+        }
+    }
+
+    void ArrayBufferAllocator::freeLarge(void* data, size_t size) {
+        if (size > MAX_POOLED_BYTES) {
+            free(data);
+            return;
+        }
+        if (_stats.pooledBytes + size > MAX_POOLED_BYTES) {
+            // The buffers in use have changed sizes, release the blocks of the other sizes and keep pooling this one.
+            for (auto i = freeLargeBlocks.begin(); i != freeLargeBlocks.end();) {
+                if (i->first == size) {
+                    ++i;
+                    continue;
+                }
+                for (auto block : i->second) {
+                    free(block);
+                }
+                _stats.pooledBytes -= i->first * i->second.size();
+                i = freeLargeBlocks.erase(i);
+            }
+            if (_stats.pooledBytes + size > MAX_POOLED_BYTES) {
+                free(data);
+                return;
+            }
+        }
+        freeLargeBlocks[size].push_back(data);
+        _stats.pooledBytes += size;
+    }
+
+    ArrayBufferStats ArrayBufferAllocator::stats() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return _stats;
+    }
+
+}
@@ -0,0 +1,124 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017-present, cyder.org
+//  All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in the
+//  Software without restriction, including without limitation the rights to use, copy,
+//  modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//  and to permit persons to whom the Software is furnished to do so, subject to the
+//  following conditions:
+//
+//      The above copyright notice and this permission notice shall be included in all
+//      copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED *AS IS*, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//  PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CYDER_ARRAYBUFFERALLOCATOR_H
+#define CYDER_ARRAYBUFFERALLOCATOR_H
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <v8.h>
+
+namespace cyder {
+
+    struct ArrayBufferStats {
+        /**
+         * The total number of bytes of the live array buffers.
+         */
+        size_t liveBytes = 0;
+        /**
+         * The highest value that liveBytes has reached.
+         */
+        size_t peakBytes = 0;
+        /**
+         * The number of live array buffers.
+         */
+        size_t liveCount = 0;
+        /**
+         * The total number of array buffers allocated.
+         */
+        uint64_t allocationCount = 0;
+        /**
+         * The number of allocations served with a block freed earlier instead of new memory.
+         */
+        uint64_t reuseCount = 0;
+        /**
+         * The number of bytes of the freed large blocks kept for reuse.
+         */
+        size_t pooledBytes = 0;
+        /**
+         * The total size of the slabs of the small blocks. The slabs are never returned to the system, so this is the
+         * peak memory used by small buffers of each size class, rounded up to whole slabs.
+         */
+        size_t slabBytes = 0;
+    };
+
+    /**
+     * ArrayBufferAllocator allocates the backing stores of all the array buffers. Small buffers are carved out of slabs
+     * by size class, and recently freed large blocks are kept for reuse, so buffers of the same size allocated every
+     * frame, such as the pixels of getImageData(), do not go through malloc() and page faults each time. The slabs are
+     * kept for the lifetime of the process (see ArrayBufferStats::slabBytes), while the pooled large blocks are bounded
+     * in total size. The backing stores may be released on any thread, all methods are thread-safe.
+     */
+    class ArrayBufferAllocator : public v8::ArrayBuffer::Allocator {
+    public:
+        /**
+         * Returns the allocator shared by all the isolates.
+         */
+        static ArrayBufferAllocator* GetInstance();
+
+        void* Allocate(size_t length) override;
+
+        void* AllocateUninitialized(size_t length) override;
+
+        void Free(void* data, size_t length) override;
+
+        ArrayBufferStats stats();
+
+    private:
+        /**
+         * The number of size classes of the small blocks, from 16 bytes to 4KB.
+         */
+        static const int SIZE_CLASS_COUNT = 9;
+
+        ArrayBufferAllocator();
+
+        void* allocate(size_t length, bool zeroed);
+
+        void* allocateSmall(int sizeClass);
+
+        void* allocateLarge(size_t size, bool zeroed);
+
+        void freeLarge(void* data, size_t size);
+
+        std::mutex mutex;
+        /**
+         * The heads of the lists of free small blocks, one per size class. A free block stores the next one in its
+         * first bytes.
+         */
+        void* freeBlocks[SIZE_CLASS_COUNT];
+        /**
+         * The freed large blocks kept for reuse, by block size. The vectors keep their capacity, so pooling a block
+         * does not allocate once a size has been seen.
+         */
+        std::unordered_map<size_t, std::vector<void*>> freeLargeBlocks;
+        ArrayBufferStats _stats;
+    };
+
+}
+
+#endif //CYDER_ARRAYBUFFERALLOCATOR_H
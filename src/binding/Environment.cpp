@@ -26,10 +26,79 @@
 
 
 #include "Environment.h"
+#include <cstdio>
 #include <fstream>
+#include "platform/FileData.h"
+#include "utils/HashUtil.h"
 
 namespace cyder {
 
+    /**
+     * The header of a code cache file. The cache is only consumed if it was produced from the same source by the same
+     * version of v8, which then runs its own checks on the data.
+     */
+    struct CodeCacheHeader {
+        uint32_t magic;
+        uint32_t dataLength;
+        uint64_t sourceHash;
+        uint64_t versionHash;
+    };
+
+    static const uint32_t CODE_CACHE_MAGIC = 0x43594443;
+
+    static std::string CodeCachePath(const std::string& path) {
+        return path + ".cache";
+    }
+
+    static CodeCacheHeader MakeCodeCacheHeader(const std::string& source) {
+        CodeCacheHeader header = {};
+        header.magic = CODE_CACHE_MAGIC;
+        header.sourceHash = HashUtil::Hash64(source.data(), source.size());
+        auto version = v8::V8::GetVersion();
+        header.versionHash = HashUtil::Hash64(version, strlen(version));
+        return header;
+    }
+
+    /**
+     * Returns the code cache stored next to the script, starting with its header, or nullptr if there is none or it
+     * does not match the expected header.
+     */
+    static sk_sp<SkData> ReadCodeCache(const std::string& path, const CodeCacheHeader& header) {
+        auto data = FileData::MapFile(CodeCachePath(path));
+        if (!data || data->size() < sizeof(CodeCacheHeader)) {
+            return nullptr;
+        }
+        CodeCacheHeader cached;
+        memcpy(&cached, data->data(), sizeof(cached));
+        if (cached.magic != header.magic || cached.sourceHash != header.sourceHash ||
+            cached.versionHash != header.versionHash || cached.dataLength != data->size() - sizeof(cached)) {
+            return nullptr;
+        }
+        return data;
+    }
+
+    /**
+     * Writes the code cache next to the script. The file is written under a temporary name first, so that other
+     * processes starting at the same time never read a partial cache.
+     */
+    static void WriteCodeCache(const std::string& path, CodeCacheHeader header,
+                               const v8::ScriptCompiler::CachedData* cachedData) {
+        auto cachePath = CodeCachePath(path);
+        auto tempPath = cachePath + ".tmp";
+        header.dataLength = static_cast<uint32_t>(cachedData->length);
+        {
+            std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            out.write(reinterpret_cast<const char*>(cachedData->data), cachedData->length);
+            if (!out.good()) {
+                out.close();
+                std::remove(tempPath.c_str());
+                return;
+            }
+        }
+        std::rename(tempPath.c_str(), cachePath.c_str());
+    }
+
     WeakHandle::WeakHandle(v8::Isolate* isolate, const v8::Local<v8::Object>& handle, std::function<void()> callback) :
             persistent(isolate, handle),
             callback(callback) {
@@ -75,6 +144,15 @@ namespace cyder {
         return new WeakHandle(_isolate, handle, callback);
     }
 
+    WeakHandle* Environment::bind(const v8::Local<v8::Object>& handle, std::function<void()> callback,
+                                  size_t externalMemory) {
+        adjustExternalMemory(static_cast<int64_t>(externalMemory));
+        return new WeakHandle(_isolate, handle, [this, callback, externalMemory]() {
+            callback();
+            adjustExternalMemory(-static_cast<int64_t>(externalMemory));
+        });
+    }
+
     v8::MaybeLocal<v8::Value> Environment::executeScript(const std::string& path) {
         std::ifstream in(path);
         std::istreambuf_iterator<char> beg(in), end;
@@ -87,20 +165,37 @@ namespace cyder {
         }
         auto source = maybeSource.ToLocalChecked();
         auto maybeJSPath = makeString(path);
-        ASSERT(!maybeSource.IsEmpty());
-        if (maybeSource.IsEmpty()) {
+        ASSERT(!maybeJSPath.IsEmpty());
+        if (maybeJSPath.IsEmpty()) {
             return v8::MaybeLocal<v8::Value>();
         }
         auto jsPath = maybeJSPath.ToLocalChecked();
         v8::ScriptOrigin origin(jsPath);
         auto context = this->context();
         v8::TryCatch tryCatch(_isolate);
-        // Compile the source code.
-        auto script = v8::Script::Compile(context, source, &origin);
+        // Compile the source code, with the code cache of the previous run if there is one.
+        auto header = MakeCodeCacheHeader(jsText);
+        auto cache = ReadCodeCache(path, header);
+        v8::ScriptCompiler::CachedData* cachedData = nullptr;
+        if (cache) {
+            cachedData = new v8::ScriptCompiler::CachedData(cache->bytes() + sizeof(CodeCacheHeader),
+                                                            static_cast<int>(cache->size() - sizeof(CodeCacheHeader)));
+        }
+        // The source takes the ownership of cachedData.
+        v8::ScriptCompiler::Source scriptSource(source, origin, cachedData);
+        auto options = cache ? v8::ScriptCompiler::kConsumeCodeCache : v8::ScriptCompiler::kProduceCodeCache;
+        auto script = v8::ScriptCompiler::Compile(context, &scriptSource, options);
         if (script.IsEmpty()) {
             printStackTrace(tryCatch);
             return v8::MaybeLocal<v8::Value>();
         }
+        auto resultData = scriptSource.GetCachedData();
+        if (!cache && resultData) {
+            WriteCodeCache(path, header, resultData);
+        } else if (cache && resultData->rejected) {
+            // v8 has compiled the script from source, e.g. its flags changed, remove the cache to produce it again.
+            std::remove(CodeCachePath(path).c_str());
+        }
         ASSERT(!script.IsEmpty());
         // Run the script to get the result.
         auto result = script.ToLocalChecked()->Run(context);
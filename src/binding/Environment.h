@@ -34,6 +34,7 @@
 #include "utils/USE.h"
 #include "utils/StringUtil.h"
 #include "platform/Log.h"
+#include "binding/PerIsolateData.h"
 
 namespace cyder {
 
@@ -70,6 +71,31 @@ namespace cyder {
         friend class Environment;
     };
 
+    /**
+     * The characters of an external one-byte string, deleted with delete[] when V8 disposes of the string.
+     */
+    class ExternalOneByteString : public v8::String::ExternalOneByteStringResource {
+    public:
+        ExternalOneByteString(char* text, size_t length) : text(text), textLength(length) {
+        }
+
+        ~ExternalOneByteString() override {
+            delete[] text;
+        }
+
+        const char* data() const override {
+            return text;
+        }
+
+        size_t length() const override {
+            return textLength;
+        }
+
+    private:
+        char* text;
+        size_t textLength;
+    };
+
     class Environment {
     public:
 
@@ -120,7 +146,35 @@ namespace cyder {
         WeakHandle* bind(const v8::Local<v8::Object>& handle, std::function<void()> callback);
 
         /**
-         * Execute a script file by file path.
+         * This method works like bind(handle, target), and also reports the native memory kept alive by the target to
+         * v8, so that the garbage collector runs according to the real memory use. The memory is reported as freed
+         * when the target is deleted. <br/>
+         * Notice: Call adjustExternalMemory() with the negative size if you delete the returned WeakHandle manually.
+         */
+        template<class T>
+        WeakHandle* bind(const v8::Local<v8::Object>& handle, T* target, size_t externalMemory) {
+            return this->bind(handle, std::bind<void>(WeakHandle::DeleteTarget<T>, std::forward<T*>(target)),
+                              externalMemory);
+        }
+
+        /**
+         * This method works like bind(handle, callback), and also reports the native memory released by the callback
+         * to v8. The memory is reported as freed after the callback is triggered. <br/>
+         * Notice: Call adjustExternalMemory() with the negative size if you delete the returned WeakHandle manually.
+         */
+        WeakHandle* bind(const v8::Local<v8::Object>& handle, std::function<void()> callback, size_t externalMemory);
+
+        /**
+         * Tells v8 how much native memory is kept alive by javascript objects. A positive change makes v8 collect
+         * garbage sooner, a negative one reports that the memory has been freed.
+         */
+        int64_t adjustExternalMemory(int64_t change) const {
+            return _isolate->AdjustAmountOfExternalAllocatedMemory(change);
+        }
+
+        /**
+         * Execute a script file by file path. The code cache produced by the first compilation is stored in a
+         * "<path>.cache" file and consumed by the next runs, until the script or the version of v8 changes.
          * @param path The path of the script file to be executed.
          * @return The result of executing script.
          */
@@ -301,6 +355,20 @@ namespace cyder {
             return v8::String::NewFromUtf8(_isolate, text.c_str(), type);
         }
 
+        /**
+         * Creates a string that refers to the Latin-1 characters instead of copying them into the V8 heap, which is
+         * much cheaper for large strings. The string takes the ownership of the characters, which must be allocated
+         * with new[]. They are deleted when the string is garbage collected, or immediately if this call fails.
+         */
+        v8::MaybeLocal<v8::String> makeExternalString(char* text, size_t length) const {
+            auto resource = new ExternalOneByteString(text, length);
+            auto result = v8::String::NewExternalOneByte(_isolate, resource);
+            if (result.IsEmpty()) {
+                delete resource;
+            }
+            return result;
+        }
+
         v8::MaybeLocal<v8::Function> makeFunction(v8::FunctionCallback callback = 0) const {
             return v8::Function::New(context(), callback, external());
         }
@@ -321,6 +389,10 @@ namespace cyder {
             return v8::ArrayBuffer::New(_isolate, byteSize);
         };
 
+        /**
+         * Creates an ArrayBuffer over existing memory. If external is false, v8 releases the memory with the
+         * ArrayBufferAllocator, so it must have been allocated by ArrayBufferAllocator::GetInstance().
+         */
         v8::Local<v8::ArrayBuffer> makeArrayBuffer(void* data, size_t byteSize, bool external = true) const {
             return v8::ArrayBuffer::New(_isolate, data, byteSize,
                                         external ? v8::ArrayBufferCreationMode::kExternalized
@@ -371,6 +443,13 @@ namespace cyder {
             return target->Get(context(), nameValue);
         }
 
+        /**
+         * Reads a property named by an atom, which does not allocate a new string for the name.
+         */
+        v8::MaybeLocal<v8::Value> getValue(const v8::Local<v8::Object>& target, Atom name) const {
+            return target->Get(context(), PerIsolateData::From(_isolate)->getAtom(name));
+        }
+
         v8::MaybeLocal<v8::Function> getFunction(const v8::Local<v8::Object>& target, const std::string& name) const {
             auto maybeValue = getValue(target, name);
             CHECK_EMPTY(maybeValue, value, v8::MaybeLocal<v8::Function>());
@@ -391,6 +470,15 @@ namespace cyder {
             return v8::MaybeLocal<v8::Object>(object);
         }
 
+        v8::MaybeLocal<v8::Object> getObject(const v8::Local<v8::Object>& target, Atom name) const {
+            auto maybeValue = getValue(target, name);
+            CHECK_EMPTY(maybeValue, value, v8::MaybeLocal<v8::Object>());
+            if (!value->IsObject()) {
+                return v8::MaybeLocal<v8::Object>();
+            }
+            auto object = v8::Local<v8::Object>::Cast(value);
+            return v8::MaybeLocal<v8::Object>(object);
+        }
 
         std::string getStdString(const v8::Local<v8::Object>& target, const std::string& name) const {
             auto maybeValue = getValue(target, name);
@@ -411,6 +499,19 @@ namespace cyder {
             return value->Int32Value(context()).FromMaybe(0);
         }
 
+        float getFloat(const v8::Local<v8::Object>& target, Atom name) const {
+            auto maybeValue = getValue(target, name);
+            CHECK_EMPTY(maybeValue, value, 0);
+            auto returnValue = value->NumberValue(context()).FromMaybe(0);
+            return static_cast<float>(returnValue);
+        }
+
+        int getInt(const v8::Local<v8::Object>& target, Atom name) const {
+            auto maybeValue = getValue(target, name);
+            CHECK_EMPTY(maybeValue, value, 0);
+            return value->Int32Value(context()).FromMaybe(0);
+        }
+
         unsigned int getUint(const v8::Local<v8::Object>& target, const std::string& name) const {
             auto maybeValue = getValue(target, name);
             CHECK_EMPTY(maybeValue, value, 0);
@@ -488,6 +589,29 @@ namespace cyder {
             }
         }
 
+        void setObjectProperty(v8::Local<v8::Object> target, Atom name, double value, bool readOnly = false) {
+            setObjectProperty(target, name, v8::Number::New(_isolate, value), readOnly);
+        }
+
+        void setObjectProperty(v8::Local<v8::Object> target, Atom name, int value, bool readOnly = false) {
+            setObjectProperty(target, name, v8::Integer::New(_isolate, value), readOnly);
+        }
+
+        /**
+         * Writes a property named by an atom, which does not allocate a new string for the name.
+         */
+        void setObjectProperty(v8::Local<v8::Object> target, Atom name, v8::Local<v8::Value> value,
+                               bool readOnly = false) {
+            auto nameValue = PerIsolateData::From(_isolate)->getAtom(name);
+            if (readOnly) {
+                auto result = target->DefineOwnProperty(context(), nameValue, value, v8::PropertyAttribute::ReadOnly);
+                USE(result);
+            } else {
+                auto result = target->Set(context(), nameValue, value);
+                USE(result);
+            }
+        }
+
         void setObjectAccessor(v8::Local<v8::Object> target, const std::string& name,
                                v8::AccessorNameGetterCallback getter,
                                v8::AccessorNameSetterCallback setter = 0) {
@@ -554,6 +678,16 @@ namespace cyder {
             }
         }
 
+        void setTemplateProperty(v8::Local<v8::Template> target, Atom name, v8::Local<v8::Data> value,
+                                 bool readOnly = false) {
+            auto nameValue = PerIsolateData::From(_isolate)->getAtom(name);
+            if (readOnly) {
+                target->Set(nameValue, value, v8::PropertyAttribute::ReadOnly);
+            } else {
+                target->Set(nameValue, value);
+            }
+        }
+
         void setTemplateAccessor(v8::Local<v8::ObjectTemplate> target, const std::string& name,
                                  v8::AccessorNameGetterCallback getter,
                                  v8::AccessorNameSetterCallback setter = 0) {
@@ -48,6 +48,11 @@ namespace cyder {
         SetException(TypeError, message, ThrowException::CreateTypeError(isolate, addExceptionContext(message)));
     }
 
+    void ExceptionState::throwIndexSizeError(const std::string& message) {
+        SetException(IndexSizeError, message,
+                     ThrowException::CreateIndexSizeError(isolate, addExceptionContext(message)));
+    }
+
     void ExceptionState::rethrowException(v8::Local<v8::Value> exception) {
         SetException(RethrownError, "", exception);
     }
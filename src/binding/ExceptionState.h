@@ -40,6 +40,7 @@ namespace cyder {
             RangeError,
             ReferenceError,
             SyntaxError,
+            IndexSizeError,
             RethrownError
         };
 
@@ -67,7 +68,7 @@ namespace cyder {
         }
 
         ExceptionState(v8::Isolate* isolate, ContextType contextType, const std::string& interfaceName)
-                : ExceptionState(isolate, contextType, interfaceName, nullptr) {
+                : ExceptionState(isolate, contextType, interfaceName, "") {
         }
 
         ~ExceptionState() {
@@ -105,6 +106,7 @@ namespace cyder {
         void throwReferenceError(const std::string& message);
         void throwSyntaxError(const std::string& message);
         void throwTypeError(const std::string& message);
+        void throwIndexSizeError(const std::string& message);
         void rethrowException(v8::Local<v8::Value> exception);
 
         void clearException();
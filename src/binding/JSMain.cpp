@@ -35,12 +35,17 @@
 #include "binding/v8/V8ImageLoader.h"
 #include "binding/v8/V8CanvasRenderingContext2D.h"
 #include "binding/v8/V8Canvas.h"
+#include "binding/v8/V8Path2D.h"
+#include "binding/PerContextData.h"
 
 
 namespace cyder {
 
     JSMain::JSMain(const std::string& nativeJSPath, Environment* env) : env(env) {
-        attachJS(nativeJSPath);
+        // An empty path means the script was already evaluated into the startup snapshot of the context.
+        if (!nativeJSPath.empty()) {
+            attachJS(nativeJSPath);
+        }
         installTemplates(env);
     }
 
@@ -53,10 +58,14 @@ namespace cyder {
         auto global = env->global();
         V8Performance::install(global, env);
         V8AnimationFrame::install(global, env);
-        V8Image::install(global, env);
         V8ImageLoader::install(global, env);
         V8CanvasRenderingContext2D::install(global, env);
-        V8Canvas::install(global, env);
+        auto perContextData = PerContextData::From(env->context());
+        env->setObjectProperty(global, "Image", perContextData->constructorForType(&V8Image::wrapperTypeInfo));
+        env->setObjectProperty(global, "Canvas", perContextData->constructorForType(&V8Canvas::wrapperTypeInfo));
+        env->setObjectProperty(global, "CanvasRenderingContext2D",
+                               perContextData->constructorForType(&V8CanvasRenderingContext2D::wrapperTypeInfo));
+        env->setObjectProperty(global, "Path2D", perContextData->constructorForType(&V8Path2D::wrapperTypeInfo));
         V8NativeApplication::install(global, env);
         V8NativeWindow::install(global, env);
     }
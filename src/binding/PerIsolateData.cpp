@@ -27,6 +27,22 @@
 #include "PerIsolateData.h"
 
 namespace cyder {
+    PerIsolateData::PerIsolateData(v8::Isolate* isolate) : _isolate(isolate) {
+        isolate->SetData(ISOLATE_EMBEDDER_DATA_INDEX, this);
+        v8::HandleScope scope(isolate);
+#define ATOM_NAME(id, name) name,
+        static const char* const atomNames[] = {CYDER_ATOMS(ATOM_NAME)};
+#undef ATOM_NAME
+        for (int i = 0; i < static_cast<int>(Atom::COUNT); i++) {
+            auto name = v8::String::NewFromUtf8(isolate, atomNames[i], v8::NewStringType::kInternalized);
+            atoms[i].Set(isolate, name.ToLocalChecked());
+        }
+    }
+
+    PerIsolateData::~PerIsolateData() {
+        _isolate->SetData(ISOLATE_EMBEDDER_DATA_INDEX, nullptr);
+    }
+
     v8::MaybeLocal<v8::FunctionTemplate> PerIsolateData::findClassTemplate(const WrapperTypeInfo* typeInfo) {
         auto result = classTemplateMap.find(typeInfo);
         if (result == classTemplateMap.end()) {
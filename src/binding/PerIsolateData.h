@@ -32,17 +32,36 @@
 #include <v8.h>
 #include "WrapperTypeInfo.h"
 
+/**
+ * The property names that the native side reads or writes on hot paths, e.g. the members of an ImageData. Each entry
+ * is V(id, name).
+ */
+#define CYDER_ATOMS(V)                          \
+    V(ALPHA, "alpha")                           \
+    V(DATA, "data")                             \
+    V(HEIGHT, "height")                         \
+    V(RECORDING, "recording")                   \
+    V(WIDTH, "width")                           \
+    V(WILL_READ_FREQUENTLY, "willReadFrequently")
+
 namespace cyder {
 
+    enum class Atom {
+#define DECLARE_ATOM(id, name) id,
+        CYDER_ATOMS(DECLARE_ATOM)
+#undef DECLARE_ATOM
+        COUNT
+    };
+
     class PerIsolateData {
     public:
         static PerIsolateData* From(v8::Isolate* isolate) {
             return static_cast<PerIsolateData*>(isolate->GetData(ISOLATE_EMBEDDER_DATA_INDEX));
         }
 
-        explicit PerIsolateData(v8::Isolate* isolate) : _isolate(isolate) {}
+        explicit PerIsolateData(v8::Isolate* isolate);
 
-        ~PerIsolateData() {};
+        ~PerIsolateData();
 
         v8::Isolate* isolate() const {
             return _isolate;
@@ -61,6 +80,13 @@ namespace cyder {
             return getStringFromCacheSlow(text);
         }
 
+        /**
+         * Returns the internalized string of a property name, the string is created once per isolate so that reading
+         * or writing the property does not allocate.
+         */
+        v8::Local<v8::String> getAtom(Atom atom) {
+            return atoms[static_cast<int>(atom)].Get(_isolate);
+        }
 
     private:
         static const int ISOLATE_EMBEDDER_DATA_INDEX = 1;
@@ -73,6 +99,7 @@ namespace cyder {
         ClassTemplateMap classTemplateMap;
         typedef std::unordered_map<std::string, v8::UniquePersistent<v8::String>> StringCacheMap;
         StringCacheMap stringCacheMap;
+        v8::Eternal<v8::String> atoms[static_cast<int>(Atom::COUNT)];
 
         v8::Local<v8::String> getStringFromCacheSlow(const std::string& text);
 
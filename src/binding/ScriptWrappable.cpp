@@ -29,6 +29,9 @@
 
 namespace cyder {
     ScriptWrappable::~ScriptWrappable() {
+        if (externalMemory) {
+            v8::Isolate::GetCurrent()->AdjustAmountOfExternalAllocatedMemory(-static_cast<int64_t>(externalMemory));
+        }
         if (persistent.IsEmpty()) {
             return;
         }
@@ -51,6 +54,17 @@ namespace cyder {
         wrapper->SetAlignedPointerInInternalField(InternalFields::WrapperObjectIndex, this);
         persistent.Reset(isolate, wrapper);
         persistent.SetWeak(this, WeakCallback, v8::WeakCallbackType::kParameter);
+        updateExternalMemory(isolate);
         return true;
     }
+
+    void ScriptWrappable::updateExternalMemory(v8::Isolate* isolate) {
+        auto bytes = memoryUsage();
+        if (bytes == externalMemory) {
+            return;
+        }
+        isolate->AdjustAmountOfExternalAllocatedMemory(static_cast<int64_t>(bytes) -
+                                                       static_cast<int64_t>(externalMemory));
+        externalMemory = bytes;
+    }
 }
\ No newline at end of file
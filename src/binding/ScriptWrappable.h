@@ -74,6 +74,19 @@ namespace cyder {
             return static_cast<T*>(this);
         }
 
+        /**
+         * Returns the number of bytes of native memory kept alive by this instance, such as decoded pixels. It is
+         * reported to v8 when the wrapper is set, so that the garbage collector runs according to the real memory use.
+         */
+        virtual size_t memoryUsage() const {
+            return 0;
+        }
+
+        /**
+         * Reports the change of memoryUsage() to v8. The reported memory is released when this instance is deleted.
+         */
+        void updateExternalMemory(v8::Isolate* isolate);
+
     private:
         static void WeakCallback(const v8::WeakCallbackInfo<ScriptWrappable>& data) {
             ScriptWrappable* nativeObject = data.GetParameter();
@@ -82,6 +95,7 @@ namespace cyder {
         }
 
         v8::Persistent<v8::Object> persistent;
+        size_t externalMemory = 0;
     };
 
 #define DEFINE_WRAPPERTYPEINFO()                               \
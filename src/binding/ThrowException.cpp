@@ -48,6 +48,14 @@ namespace cyder {
         return v8::Exception::TypeError(ToV8(isolate, message));
     }
 
+    v8::Local<v8::Value> ThrowException::CreateIndexSizeError(v8::Isolate* isolate, const std::string& message) {
+        auto error = v8::Exception::Error(ToV8(isolate, message)).As<v8::Object>();
+        auto context = isolate->GetCurrentContext();
+        error->Set(context, ToV8(isolate, "name"), ToV8(isolate, "IndexSizeError")).FromJust();
+        error->Set(context, ToV8(isolate, "code"), ToV8(isolate, 1)).FromJust();
+        return error;
+    }
+
     void ThrowException::ThrowError(v8::Isolate* isolate, const std::string& message) {
         Throw(isolate, CreateError(isolate, message));
     }
@@ -67,4 +75,8 @@ namespace cyder {
     void ThrowException::ThrowTypeError(v8::Isolate* isolate, const std::string& message) {
         Throw(isolate, CreateTypeError(isolate, message));
     }
+
+    void ThrowException::ThrowIndexSizeError(v8::Isolate* isolate, const std::string& message) {
+        Throw(isolate, CreateIndexSizeError(isolate, message));
+    }
 }
\ No newline at end of file
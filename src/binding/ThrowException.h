@@ -45,12 +45,18 @@ namespace cyder {
         static v8::Local<v8::Value> CreateReferenceError(v8::Isolate* isolate, const std::string& message);
         static v8::Local<v8::Value> CreateSyntaxError(v8::Isolate* isolate, const std::string& message);
         static v8::Local<v8::Value> CreateTypeError(v8::Isolate* isolate, const std::string& message);
+        /**
+         * Creates an Error named "IndexSizeError" with the code of the DOMException of the same name, which is thrown
+         * when an index or a size is negative, zero, or out of the allowed range.
+         */
+        static v8::Local<v8::Value> CreateIndexSizeError(v8::Isolate* isolate, const std::string& message);
 
         static void ThrowError(v8::Isolate* isolate, const std::string& message);
         static void ThrowRangeError(v8::Isolate* isolate, const std::string& message);
         static void ThrowReferenceError(v8::Isolate* isolate, const std::string& message);
         static void ThrowSyntaxError(v8::Isolate* isolate, const std::string& message);
         static void ThrowTypeError(v8::Isolate* isolate, const std::string& message);
+        static void ThrowIndexSizeError(v8::Isolate* isolate, const std::string& message);
     };
 
 }
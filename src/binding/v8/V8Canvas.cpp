@@ -24,126 +24,164 @@
 //
 //////////////////////////////////////////////////////////////////////////////////////
 
+
 #include "V8Canvas.h"
-#include "modules/canvas2d/CanvasRenderingContext2D.h"
+#include "V8CanvasRenderingContext2D.h"
+#include "V8Image.h"
+#include "binding/ObjectConstructor.h"
 #include "modules/canvas/OffScreenBuffer.h"
-#include "modules/canvas/Canvas.h"
 
 namespace cyder {
 
-    static void widthGetter(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args) {
-        auto canvas = static_cast<Canvas*>(args.This()->GetAlignedPointerFromInternalField(0));
-        args.GetReturnValue().Set(canvas->width());
+    void V8Canvas::constructorCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto isolate = info.GetIsolate();
+        if (ConstructorScope::IsValid(isolate)) {
+            // Creating the boilerplate of the wrappers of native canvases.
+            SetReturnValue(info, info.Holder());
+            return;
+        }
+        ExceptionState exceptionState(isolate, ExceptionState::ConstructionContext, "Canvas");
+        auto width = ToInt32(isolate, info[0], exceptionState);
+        auto height = ToInt32(isolate, info[1], exceptionState);
+        if (exceptionState.hadException()) {
+            return;
+        }
+        auto impl = new Canvas(width, height);
+        auto wrapper = info.Holder();
+        impl->setWrapper(isolate, wrapper);
+        SetReturnValue(info, wrapper);
     }
 
-    static void widthSetter(v8::Local<v8::Name> property, v8::Local<v8::Value> value,
-                            const v8::PropertyCallbackInfo<void>& args) {
-        auto env = Environment::GetCurrent(args);
-        auto canvas = static_cast<Canvas*>(args.This()->GetAlignedPointerFromInternalField(0));
-        canvas->setWidth(env->toInt(value));
+    void V8Canvas::widthAttributeGetterCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto impl = V8Canvas::toImpl(info.Holder());
+        SetReturnValue(info, impl->width());
     }
 
-    static void heightGetter(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args) {
-        auto canvas = static_cast<Canvas*>(args.This()->GetAlignedPointerFromInternalField(0));
-        args.GetReturnValue().Set(canvas->height());
+    void V8Canvas::widthAttributeSetterCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto isolate = info.GetIsolate();
+        ExceptionState exceptionState(isolate, ExceptionState::SetterContext, "Canvas", "width");
+        auto impl = V8Canvas::toImpl(info.Holder());
+        auto value = ToInt32(isolate, info[0], exceptionState);
+        if (exceptionState.hadException()) {
+            return;
+        }
+        impl->setWidth(value);
+        impl->updateExternalMemory(isolate);
+    }
+
+    void V8Canvas::heightAttributeGetterCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto impl = V8Canvas::toImpl(info.Holder());
+        SetReturnValue(info, impl->height());
+    }
+
+    void V8Canvas::heightAttributeSetterCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto isolate = info.GetIsolate();
+        ExceptionState exceptionState(isolate, ExceptionState::SetterContext, "Canvas", "height");
+        auto impl = V8Canvas::toImpl(info.Holder());
+        auto value = ToInt32(isolate, info[0], exceptionState);
+        if (exceptionState.hadException()) {
+            return;
+        }
+        impl->setHeight(value);
+        impl->updateExternalMemory(isolate);
     }
 
-    static void heightSetter(v8::Local<v8::Name> property, v8::Local<v8::Value> value,
-                             const v8::PropertyCallbackInfo<void>& args) {
-        auto env = Environment::GetCurrent(args);
-        auto canvas = static_cast<Canvas*>(args.This()->GetAlignedPointerFromInternalField(0));
-        canvas->setHeight(env->toInt(value));
+    /**
+     * Reads a boolean member of the context attributes, returns defaultValue if it is not present.
+     */
+    static bool ReadContextAttribute(v8::Isolate* isolate, v8::Local<v8::Object> attributes, Atom name,
+                                     bool defaultValue, ExceptionState& exceptionState) {
+        auto nameValue = PerIsolateData::From(isolate)->getAtom(name);
+        v8::Local<v8::Value> value;
+        if (!attributes->Get(isolate->GetCurrentContext(), nameValue).ToLocal(&value) ||
+            value->IsUndefined()) {
+            return defaultValue;
+        }
+        return ToBoolean(isolate, value, exceptionState);
     }
 
-    static void getContextMethod(const v8::FunctionCallbackInfo<v8::Value>& args) {
-        auto env = Environment::GetCurrent(args);
-        v8::HandleScope scope(env->isolate());
-        auto self = args.This();
-        auto canvas = static_cast<Canvas*>(self->GetAlignedPointerFromInternalField(0));
-        auto contextType = env->toStdString(args[0]);
-        if (canvas->context) {
-            if (canvas->contextType == contextType) {
-                args.GetReturnValue().Set(env->toLocal(canvas->contextObject));
+    void V8Canvas::getContextMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto isolate = info.GetIsolate();
+        ExceptionState exceptionState(isolate, ExceptionState::ExecutionContext, "Canvas", "getContext");
+        auto impl = V8Canvas::toImpl(info.Holder());
+        auto contextType = ToStdString(isolate, info[0], exceptionState);
+        if (exceptionState.hadException()) {
+            return;
+        }
+        if (impl->context) {
+            if (impl->contextType == contextType) {
+                SetReturnValue(info, static_cast<CanvasRenderingContext2D*>(impl->context));
             } else {
-                args.GetReturnValue().Set(env->makeNull());
+                SetReturnValueNull(info);
             }
             return;
         }
-
-        canvas->contextType = contextType;
-        if (contextType == "2d") {
-            auto CanvasRenderingContext2DClass = env->readGlobalFunction("CanvasRenderingContext2D");
-            if (!canvas->buffer) {
-                bool hasAlpha = true;
-                bool useGPU = true;
-                if (args[1]->IsObject()) {
-                    auto contextAttributes = v8::Local<v8::Object>::Cast(args[1]);
-                    auto alphaValue = env->getValue(contextAttributes, "alpha");
-                    if (!alphaValue.IsEmpty()) {
-                        hasAlpha = alphaValue.ToLocalChecked()->BooleanValue(env->context()).FromMaybe(false);
-                    }
-                    auto willReadFrequentlyValue = env->getValue(contextAttributes, "willReadFrequently");
-                    if (!willReadFrequentlyValue.IsEmpty()) {
-                        useGPU = !willReadFrequentlyValue.ToLocalChecked()->
-                                BooleanValue(env->context()).FromMaybe(false);
-                    }
+        impl->contextType = contextType;
+        if (contextType != "2d") {
+            SetReturnValueNull(info);
+            return;
+        }
+        if (!impl->buffer) {
+            bool hasAlpha = true;
+            bool useGPU = true;
+            bool recording = false;
+            if (info[1]->IsObject()) {
+                auto attributes = v8::Local<v8::Object>::Cast(info[1]);
+                hasAlpha = ReadContextAttribute(isolate, attributes, Atom::ALPHA, true, exceptionState);
+                useGPU = !ReadContextAttribute(isolate, attributes, Atom::WILL_READ_FREQUENTLY, false, exceptionState);
+                recording = ReadContextAttribute(isolate, attributes, Atom::RECORDING, false, exceptionState);
+                if (exceptionState.hadException()) {
+                    return;
                 }
-                canvas->buffer = new OffScreenBuffer(canvas->width(), canvas->height(), hasAlpha, useGPU);
             }
-            canvas->context = new CanvasRenderingContext2D(canvas->buffer);
-            auto contextObject = env->newInstance(CanvasRenderingContext2DClass,
-                                                  env->makeExternal(canvas->context)).ToLocalChecked();
-            canvas->contextObject.Reset(env->isolate(), contextObject);
-            args.GetReturnValue().Set(contextObject);
-        } else {
-            args.GetReturnValue().Set(env->makeNull());
+            impl->buffer = new OffScreenBuffer(impl->width(), impl->height(), hasAlpha, useGPU, recording);
+            impl->updateExternalMemory(isolate);
         }
+        auto context = new CanvasRenderingContext2D(impl->buffer);
+        impl->context = context;
+        auto wrapper = info.Holder();
+        auto contextWrapper = ToV8(isolate, wrapper, context).As<v8::Object>();
+        // The context draws into the buffer of the canvas, keep both of them alive as long as either is reachable.
+        AddHiddenValueToTarget(isolate, wrapper, contextWrapper);
+        AddHiddenValueToTarget(isolate, contextWrapper, wrapper);
+        SetReturnValue(info, contextWrapper);
     }
 
-    static void makeImageSnapshotMethod(const v8::FunctionCallbackInfo<v8::Value>& args) {
-        auto env = Environment::GetCurrent(args);
-        v8::HandleScope scope(env->isolate());
-        auto self = args.This();
-        auto canvas = static_cast<Canvas*>(self->GetAlignedPointerFromInternalField(0));
+    void V8Canvas::makeImageSnapshotMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto impl = V8Canvas::toImpl(info.Holder());
         Image* image;
-        if (canvas->buffer) {
-            image = canvas->buffer->makeImageSnapshot();
+        if (impl->buffer) {
+            image = impl->buffer->makeImageSnapshot();
         } else {
             SkBitmap bitmap;
-            bitmap.allocN32Pixels(canvas->width(), canvas->height());
+            bitmap.allocN32Pixels(impl->width(), impl->height());
             auto pixels = SkImage::MakeFromBitmap(bitmap).release();
             image = new Image(pixels);
         }
-        auto ImageClass = env->readGlobalFunction("Image");
-        auto imageObject = env->newInstance(ImageClass, env->makeExternal(image)).ToLocalChecked();
-        args.GetReturnValue().Set(imageObject);
+        SetReturnValue(info, image);
     }
 
-    static void constructor(const v8::FunctionCallbackInfo<v8::Value>& args) {
-        auto env = Environment::GetCurrent(args);
-        v8::HandleScope scope(env->isolate());
-        Canvas* canvas;
-        if (args[0]->IsExternal()) {
-            auto external = v8::Local<v8::External>::Cast(args[0]);
-            auto buffer = reinterpret_cast<DrawingBuffer*>(external->Value());
-            canvas = new Canvas(buffer);
-        } else {
-            int width = env->toInt(args[0]);
-            int height = env->toInt(args[1]);
-            canvas = new Canvas(width, height);
-        }
-        auto self = args.This();
-        self->SetAlignedPointerInInternalField(0, canvas);
-        env->bind(self, canvas);
+    Canvas* V8Canvas::toImplWithTypeCheck(v8::Isolate* isolate, v8::Local<v8::Value> value) {
+        return V8Binding::HasInstance(isolate, &wrapperTypeInfo, value) ?
+               toImpl(v8::Local<v8::Object>::Cast(value)) : nullptr;
     }
 
-    void V8Canvas::install(v8::Local<v8::Object> parent, Environment* env) {
-        auto classTemplate = env->makeFunctionTemplate(constructor);
-        auto prototypeTemplate = classTemplate->PrototypeTemplate();
-        env->setTemplateAccessor(prototypeTemplate, "width", widthGetter, widthSetter);
-        env->setTemplateAccessor(prototypeTemplate, "height", heightGetter, heightSetter);
-        env->setTemplateProperty(prototypeTemplate, "getContext", getContextMethod);
-        env->setTemplateProperty(prototypeTemplate, "makeImageSnapshot", makeImageSnapshotMethod);
-        env->attachClass(parent, "Canvas", classTemplate);
-    }
-}
\ No newline at end of file
+    static const AccessorConfiguration V8CanvasAccessors[] = {
+            {"width",  V8Canvas::widthAttributeGetterCallback,  V8Canvas::widthAttributeSetterCallback,  v8::None, InstallOnPrototype},
+            {"height", V8Canvas::heightAttributeGetterCallback, V8Canvas::heightAttributeSetterCallback, v8::None, InstallOnPrototype}
+    };
+
+    static const MethodConfiguration V8CanvasMethods[] = {
+            {"getContext",        V8Canvas::getContextMethodCallback,        1, v8::None, InstallOnPrototype},
+            {"makeImageSnapshot", V8Canvas::makeImageSnapshotMethodCallback, 0, v8::None, InstallOnPrototype}
+    };
+
+    const WrapperTypeInfo V8Canvas::wrapperTypeInfo = {nullptr, "Canvas",
+                                                       V8Canvas::constructorCallback, 0,
+                                                       V8CanvasAccessors, 2,
+                                                       V8CanvasMethods, 2,
+                                                       nullptr, 0,
+                                                       nullptr, 0};
+
+    const WrapperTypeInfo& Canvas::wrapperTypeInfo = V8Canvas::wrapperTypeInfo;
+}
@@ -27,14 +27,30 @@
 #ifndef CYDER_V8CANVAS_H
 #define CYDER_V8CANVAS_H
 
-#include <v8.h>
-#include "binding/Environment.h"
+#include "binding/V8Binding.h"
+#include "modules/canvas/Canvas.h"
 
 namespace cyder {
 
     class V8Canvas {
     public:
-        static void install(v8::Local<v8::Object> parent, Environment* env);
+
+        static Canvas* toImpl(v8::Local<v8::Object> object) {
+            return ToScriptWrappable(object)->toImpl<Canvas>();
+        }
+
+        static Canvas* toImplWithTypeCheck(v8::Isolate* isolate, v8::Local<v8::Value> value);
+        static const WrapperTypeInfo wrapperTypeInfo;
+
+        static void constructorCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+
+        static void widthAttributeGetterCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void widthAttributeSetterCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void heightAttributeGetterCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void heightAttributeSetterCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+
+        static void getContextMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void makeImageSnapshotMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
     };
 
 }
@@ -24,52 +24,889 @@
 //
 //////////////////////////////////////////////////////////////////////////////////////
 
+
 #include "V8CanvasRenderingContext2D.h"
-#include "modules/canvas2d/CanvasRenderingContext2D.h"
 #include <skia.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "V8Image.h"
+#include "V8Path2D.h"
+#include "binding/ObjectConstructor.h"
+#include "modules/canvas2d/CSSColor.h"
+#include "modules/canvas2d/FontManager.h"
 
 namespace cyder {
-    static void drawImageMethod(const v8::FunctionCallbackInfo<v8::Value>& args) {
-        auto env = Environment::GetCurrent(args);
-        v8::HandleScope scope(env->isolate());
-        auto self = args.This();
-        auto context = static_cast<CanvasRenderingContext2D*>(self->GetAlignedPointerFromInternalField(0));
-        auto imageObject = v8::Local<v8::Object>::Cast(args[0]);
-        auto image = static_cast<CanvasImageSource*>(imageObject->GetAlignedPointerFromInternalField(0));
+
+    void V8CanvasRenderingContext2D::constructorCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto isolate = info.GetIsolate();
+        if (ConstructorScope::IsValid(isolate)) {
+            // Creating the boilerplate of the wrappers of native contexts.
+            SetReturnValue(info, info.Holder());
+            return;
+        }
+        // Contexts are only created by Canvas.getContext().
+        ExceptionState exceptionState(isolate, ExceptionState::ConstructionContext, "CanvasRenderingContext2D");
+        exceptionState.throwTypeError("Illegal constructor");
+    }
+
+    void V8CanvasRenderingContext2D::globalAlphaAttributeGetterCallback(
+            const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto impl = V8CanvasRenderingContext2D::toImpl(info.Holder());
+        SetReturnValue(info, impl->globalAlpha());
+    }
+
+    void V8CanvasRenderingContext2D::globalAlphaAttributeSetterCallback(
+            const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto isolate = info.GetIsolate();
+        ExceptionState exceptionState(isolate, ExceptionState::SetterContext, "CanvasRenderingContext2D",
+                                      "globalAlpha");
+        auto impl = V8CanvasRenderingContext2D::toImpl(info.Holder());
+        auto value = ToFloat(isolate, info[0], exceptionState);
+        if (exceptionState.hadException()) {
+            return;
+        }
+        impl->setGlobalAlpha(value);
+    }
+
+    void V8CanvasRenderingContext2D::globalCompositeOperationAttributeGetterCallback(
+            const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto impl = V8CanvasRenderingContext2D::toImpl(info.Holder());
+        SetReturnValue(info, impl->globalCompositeOperation());
+    }
+
+    void V8CanvasRenderingContext2D::globalCompositeOperationAttributeSetterCallback(
+            const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto isolate = info.GetIsolate();
+        ExceptionState exceptionState(isolate, ExceptionState::SetterContext, "CanvasRenderingContext2D",
+                                      "globalCompositeOperation");
+        auto impl = V8CanvasRenderingContext2D::toImpl(info.Holder());
+        auto value = ToStdString(isolate, info[0], exceptionState);
+        if (exceptionState.hadException()) {
+            return;
+        }
+        impl->setGlobalCompositeOperation(value);
+    }
+
+    void V8CanvasRenderingContext2D::imageSmoothingEnabledAttributeGetterCallback(
+            const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto impl = V8CanvasRenderingContext2D::toImpl(info.Holder());
+        SetReturnValue(info, impl->imageSmoothingEnabled());
+    }
+
+    void V8CanvasRenderingContext2D::imageSmoothingEnabledAttributeSetterCallback(
+            const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto isolate = info.GetIsolate();
+        ExceptionState exceptionState(isolate, ExceptionState::SetterContext, "CanvasRenderingContext2D",
+                                      "imageSmoothingEnabled");
+        auto impl = V8CanvasRenderingContext2D::toImpl(info.Holder());
+        auto value = ToBoolean(isolate, info[0], exceptionState);
+        if (exceptionState.hadException()) {
+            return;
+        }
+        impl->setImageSmoothingEnabled(value);
+    }
+
+    void V8CanvasRenderingContext2D::fillStyleAttributeGetterCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto impl = V8CanvasRenderingContext2D::toImpl(info.Holder());
+        SetReturnValue(info, impl->fillStyle());
+    }
+
+    void V8CanvasRenderingContext2D::fillStyleAttributeSetterCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto isolate = info.GetIsolate();
+        ExceptionState exceptionState(isolate, ExceptionState::SetterContext, "CanvasRenderingContext2D", "fillStyle");
+        auto impl = V8CanvasRenderingContext2D::toImpl(info.Holder());
+        auto value = ToStdString(isolate, info[0], exceptionState);
+        if (exceptionState.hadException()) {
+            return;
+        }
+        impl->setFillStyle(value);
+    }
+
+    void V8CanvasRenderingContext2D::strokeStyleAttributeGetterCallback(
+            const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto impl = V8CanvasRenderingContext2D::toImpl(info.Holder());
+        SetReturnValue(info, impl->strokeStyle());
+    }
+
+    void V8CanvasRenderingContext2D::strokeStyleAttributeSetterCallback(
+            const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto isolate = info.GetIsolate();
+        ExceptionState exceptionState(isolate, ExceptionState::SetterContext, "CanvasRenderingContext2D",
+                                      "strokeStyle");
+        auto impl = V8CanvasRenderingContext2D::toImpl(info.Holder());
+        auto value = ToStdString(isolate, info[0], exceptionState);
+        if (exceptionState.hadException()) {
+            return;
+        }
+        impl->setStrokeStyle(value);
+    }
+
+    void V8CanvasRenderingContext2D::lineWidthAttributeGetterCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto impl = V8CanvasRenderingContext2D::toImpl(info.Holder());
+        SetReturnValue(info, impl->lineWidth());
+    }
+
+    void V8CanvasRenderingContext2D::lineWidthAttributeSetterCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto isolate = info.GetIsolate();
+        ExceptionState exceptionState(isolate, ExceptionState::SetterContext, "CanvasRenderingContext2D", "lineWidth");
+        auto impl = V8CanvasRenderingContext2D::toImpl(info.Holder());
+        auto value = ToFloat(isolate, info[0], exceptionState);
+        if (exceptionState.hadException()) {
+            return;
+        }
+        impl->setLineWidth(value);
+    }
+
+    void V8CanvasRenderingContext2D::fontAttributeGetterCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto impl = V8CanvasRenderingContext2D::toImpl(info.Holder());
+        SetReturnValue(info, impl->font());
+    }
+
+    void V8CanvasRenderingContext2D::fontAttributeSetterCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto isolate = info.GetIsolate();
+        ExceptionState exceptionState(isolate, ExceptionState::SetterContext, "CanvasRenderingContext2D", "font");
+        auto impl = V8CanvasRenderingContext2D::toImpl(info.Holder());
+        auto value = ToStdString(isolate, info[0], exceptionState);
+        if (exceptionState.hadException()) {
+            return;
+        }
+        impl->setFont(value);
+    }
+
+    void V8CanvasRenderingContext2D::textAlignAttributeGetterCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto impl = V8CanvasRenderingContext2D::toImpl(info.Holder());
+        SetReturnValue(info, impl->textAlign());
+    }
+
+    void V8CanvasRenderingContext2D::textAlignAttributeSetterCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto isolate = info.GetIsolate();
+        ExceptionState exceptionState(isolate, ExceptionState::SetterContext, "CanvasRenderingContext2D", "textAlign");
+        auto impl = V8CanvasRenderingContext2D::toImpl(info.Holder());
+        auto value = ToStdString(isolate, info[0], exceptionState);
+        if (exceptionState.hadException()) {
+            return;
+        }
+        impl->setTextAlign(value);
+    }
+
+    void V8CanvasRenderingContext2D::textBaselineAttributeGetterCallback(
+            const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto impl = V8CanvasRenderingContext2D::toImpl(info.Holder());
+        SetReturnValue(info, impl->textBaseline());
+    }
+
+    void V8CanvasRenderingContext2D::textBaselineAttributeSetterCallback(
+            const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto isolate = info.GetIsolate();
+        ExceptionState exceptionState(isolate, ExceptionState::SetterContext, "CanvasRenderingContext2D",
+                                      "textBaseline");
+        auto impl = V8CanvasRenderingContext2D::toImpl(info.Holder());
+        auto value = ToStdString(isolate, info[0], exceptionState);
+        if (exceptionState.hadException()) {
+            return;
+        }
+        impl->setTextBaseline(value);
+    }
+
+    void V8CanvasRenderingContext2D::saveMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        V8CanvasRenderingContext2D::toImpl(info.Holder())->save();
+    }
+
+    void V8CanvasRenderingContext2D::restoreMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        V8CanvasRenderingContext2D::toImpl(info.Holder())->restore();
+    }
+
+    void V8CanvasRenderingContext2D::translateMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto isolate = info.GetIsolate();
+        ExceptionState exceptionState(isolate, ExceptionState::ExecutionContext, "CanvasRenderingContext2D",
+                                      "translate");
+        auto impl = V8CanvasRenderingContext2D::toImpl(info.Holder());
+        if (info.Length() < 2) {
+            exceptionState.throwTypeError(ExceptionMessages::NotEnoughArguments(2, info.Length()));
+            return;
+        }
+        auto x = ToFloat(isolate, info[0], exceptionState);
+        auto y = ToFloat(isolate, info[1], exceptionState);
+        if (exceptionState.hadException()) {
+            return;
+        }
+        impl->translate(x, y);
+    }
+
+    void V8CanvasRenderingContext2D::rotateMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto isolate = info.GetIsolate();
+        ExceptionState exceptionState(isolate, ExceptionState::ExecutionContext, "CanvasRenderingContext2D", "rotate");
+        auto impl = V8CanvasRenderingContext2D::toImpl(info.Holder());
+        if (info.Length() < 1) {
+            exceptionState.throwTypeError(ExceptionMessages::NotEnoughArguments(1, info.Length()));
+            return;
+        }
+        auto angle = ToFloat(isolate, info[0], exceptionState);
+        if (exceptionState.hadException()) {
+            return;
+        }
+        impl->rotate(angle);
+    }
+
+    void V8CanvasRenderingContext2D::scaleMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto isolate = info.GetIsolate();
+        ExceptionState exceptionState(isolate, ExceptionState::ExecutionContext, "CanvasRenderingContext2D", "scale");
+        auto impl = V8CanvasRenderingContext2D::toImpl(info.Holder());
+        if (info.Length() < 2) {
+            exceptionState.throwTypeError(ExceptionMessages::NotEnoughArguments(2, info.Length()));
+            return;
+        }
+        auto x = ToFloat(isolate, info[0], exceptionState);
+        auto y = ToFloat(isolate, info[1], exceptionState);
+        if (exceptionState.hadException()) {
+            return;
+        }
+        impl->scale(x, y);
+    }
+
+    /**
+     * Reads the six matrix arguments of transform() and setTransform(), returns false if any of them is invalid.
+     */
+    static bool ReadMatrixArguments(const v8::FunctionCallbackInfo<v8::Value>& info, ExceptionState& exceptionState,
+                                    float matrix[6]) {
+        if (info.Length() < 6) {
+            exceptionState.throwTypeError(ExceptionMessages::NotEnoughArguments(6, info.Length()));
+            return false;
+        }
+        auto isolate = info.GetIsolate();
+        for (int i = 0; i < 6; i++) {
+            matrix[i] = ToFloat(isolate, info[i], exceptionState);
+        }
+        return !exceptionState.hadException();
+    }
+
+    void V8CanvasRenderingContext2D::transformMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        ExceptionState exceptionState(info.GetIsolate(), ExceptionState::ExecutionContext, "CanvasRenderingContext2D",
+                                      "transform");
+        auto impl = V8CanvasRenderingContext2D::toImpl(info.Holder());
+        float m[6];
+        if (!ReadMatrixArguments(info, exceptionState, m)) {
+            return;
+        }
+        impl->transform(m[0], m[1], m[2], m[3], m[4], m[5]);
+    }
+
+    void V8CanvasRenderingContext2D::setTransformMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        ExceptionState exceptionState(info.GetIsolate(), ExceptionState::ExecutionContext, "CanvasRenderingContext2D",
+                                      "setTransform");
+        auto impl = V8CanvasRenderingContext2D::toImpl(info.Holder());
+        float m[6];
+        if (!ReadMatrixArguments(info, exceptionState, m)) {
+            return;
+        }
+        impl->setTransform(m[0], m[1], m[2], m[3], m[4], m[5]);
+    }
+
+    void V8CanvasRenderingContext2D::resetTransformMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        V8CanvasRenderingContext2D::toImpl(info.Holder())->resetTransform();
+    }
+
+    void V8CanvasRenderingContext2D::beginPathMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        V8CanvasRenderingContext2D::toImpl(info.Holder())->beginPath();
+    }
+
+    void V8CanvasRenderingContext2D::closePathMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        V8CanvasRenderingContext2D::toImpl(info.Holder())->closePath();
+    }
+
+    void V8CanvasRenderingContext2D::moveToMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto isolate = info.GetIsolate();
+        ExceptionState exceptionState(isolate, ExceptionState::ExecutionContext, "CanvasRenderingContext2D", "moveTo");
+        auto impl = V8CanvasRenderingContext2D::toImpl(info.Holder());
+        if (info.Length() < 2) {
+            exceptionState.throwTypeError(ExceptionMessages::NotEnoughArguments(2, info.Length()));
+            return;
+        }
+        auto x = ToFloat(isolate, info[0], exceptionState);
+        auto y = ToFloat(isolate, info[1], exceptionState);
+        if (exceptionState.hadException()) {
+            return;
+        }
+        impl->moveTo(x, y);
+    }
+
+    void V8CanvasRenderingContext2D::lineToMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto isolate = info.GetIsolate();
+        ExceptionState exceptionState(isolate, ExceptionState::ExecutionContext, "CanvasRenderingContext2D", "lineTo");
+        auto impl = V8CanvasRenderingContext2D::toImpl(info.Holder());
+        if (info.Length() < 2) {
+            exceptionState.throwTypeError(ExceptionMessages::NotEnoughArguments(2, info.Length()));
+            return;
+        }
+        auto x = ToFloat(isolate, info[0], exceptionState);
+        auto y = ToFloat(isolate, info[1], exceptionState);
+        if (exceptionState.hadException()) {
+            return;
+        }
+        impl->lineTo(x, y);
+    }
+
+    void V8CanvasRenderingContext2D::quadraticCurveToMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto isolate = info.GetIsolate();
+        ExceptionState exceptionState(isolate, ExceptionState::ExecutionContext, "CanvasRenderingContext2D",
+                                      "quadraticCurveTo");
+        auto impl = V8CanvasRenderingContext2D::toImpl(info.Holder());
+        if (info.Length() < 4) {
+            exceptionState.throwTypeError(ExceptionMessages::NotEnoughArguments(4, info.Length()));
+            return;
+        }
+        auto cpx = ToFloat(isolate, info[0], exceptionState);
+        auto cpy = ToFloat(isolate, info[1], exceptionState);
+        auto x = ToFloat(isolate, info[2], exceptionState);
+        auto y = ToFloat(isolate, info[3], exceptionState);
+        if (exceptionState.hadException()) {
+            return;
+        }
+        impl->quadraticCurveTo(cpx, cpy, x, y);
+    }
+
+    void V8CanvasRenderingContext2D::bezierCurveToMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto isolate = info.GetIsolate();
+        ExceptionState exceptionState(isolate, ExceptionState::ExecutionContext, "CanvasRenderingContext2D",
+                                      "bezierCurveTo");
+        auto impl = V8CanvasRenderingContext2D::toImpl(info.Holder());
+        if (info.Length() < 6) {
+            exceptionState.throwTypeError(ExceptionMessages::NotEnoughArguments(6, info.Length()));
+            return;
+        }
+        auto cp1x = ToFloat(isolate, info[0], exceptionState);
+        auto cp1y = ToFloat(isolate, info[1], exceptionState);
+        auto cp2x = ToFloat(isolate, info[2], exceptionState);
+        auto cp2y = ToFloat(isolate, info[3], exceptionState);
+        auto x = ToFloat(isolate, info[4], exceptionState);
+        auto y = ToFloat(isolate, info[5], exceptionState);
+        if (exceptionState.hadException()) {
+            return;
+        }
+        impl->bezierCurveTo(cp1x, cp1y, cp2x, cp2y, x, y);
+    }
+
+    void V8CanvasRenderingContext2D::arcMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto isolate = info.GetIsolate();
+        ExceptionState exceptionState(isolate, ExceptionState::ExecutionContext, "CanvasRenderingContext2D", "arc");
+        auto impl = V8CanvasRenderingContext2D::toImpl(info.Holder());
+        if (info.Length() < 5) {
+            exceptionState.throwTypeError(ExceptionMessages::NotEnoughArguments(5, info.Length()));
+            return;
+        }
+        auto x = ToFloat(isolate, info[0], exceptionState);
+        auto y = ToFloat(isolate, info[1], exceptionState);
+        auto radius = ToFloat(isolate, info[2], exceptionState);
+        auto startAngle = ToFloat(isolate, info[3], exceptionState);
+        auto endAngle = ToFloat(isolate, info[4], exceptionState);
+        auto anticlockwise = info.Length() > 5 && ToBoolean(isolate, info[5], exceptionState);
+        if (exceptionState.hadException()) {
+            return;
+        }
+        if (!impl->arc(x, y, radius, startAngle, endAngle, anticlockwise)) {
+            exceptionState.throwRangeError("The radius provided (" + std::to_string(radius) + ") is negative.");
+        }
+    }
+
+    void V8CanvasRenderingContext2D::rectMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto isolate = info.GetIsolate();
+        ExceptionState exceptionState(isolate, ExceptionState::ExecutionContext, "CanvasRenderingContext2D", "rect");
+        auto impl = V8CanvasRenderingContext2D::toImpl(info.Holder());
+        if (info.Length() < 4) {
+            exceptionState.throwTypeError(ExceptionMessages::NotEnoughArguments(4, info.Length()));
+            return;
+        }
+        auto x = ToFloat(isolate, info[0], exceptionState);
+        auto y = ToFloat(isolate, info[1], exceptionState);
+        auto width = ToFloat(isolate, info[2], exceptionState);
+        auto height = ToFloat(isolate, info[3], exceptionState);
+        if (exceptionState.hadException()) {
+            return;
+        }
+        impl->rect(x, y, width, height);
+    }
+
+    /**
+     * Reads the optional Path2D and fill rule arguments of fill(), stroke() and clip().
+     */
+    static bool ReadPathArguments(const v8::FunctionCallbackInfo<v8::Value>& info, ExceptionState& exceptionState,
+                                  Path2D** path, CanvasFillRule* fillRule) {
+        auto isolate = info.GetIsolate();
+        int index = 0;
+        *path = nullptr;
+        if (info.Length() > 0 && info[0]->IsObject()) {
+            *path = V8Path2D::toImplWithTypeCheck(isolate, info[0]);
+            if (!*path) {
+                exceptionState.throwTypeError(ExceptionMessages::ArgumentNullOrIncorrectType(1, "Path2D"));
+                return false;
+            }
+            index++;
+        }
+        *fillRule = CanvasFillRule::NONZERO;
+        if (info.Length() > index && !info[index]->IsUndefined()) {
+            auto value = ToStdString(isolate, info[index], exceptionState);
+            if (exceptionState.hadException()) {
+                return false;
+            }
+            if (value == "evenodd") {
+                *fillRule = CanvasFillRule::EVENODD;
+            } else if (value != "nonzero") {
+                exceptionState.throwTypeError("The provided value '" + value +
+                                              "' is not a valid enum value of type CanvasFillRule.");
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void V8CanvasRenderingContext2D::fillMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        ExceptionState exceptionState(info.GetIsolate(), ExceptionState::ExecutionContext, "CanvasRenderingContext2D",
+                                      "fill");
+        auto impl = V8CanvasRenderingContext2D::toImpl(info.Holder());
+        Path2D* path;
+        CanvasFillRule fillRule;
+        if (!ReadPathArguments(info, exceptionState, &path, &fillRule)) {
+            return;
+        }
+        if (path) {
+            impl->fill(path, fillRule);
+        } else {
+            impl->fill(fillRule);
+        }
+    }
+
+    void V8CanvasRenderingContext2D::strokeMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        ExceptionState exceptionState(info.GetIsolate(), ExceptionState::ExecutionContext, "CanvasRenderingContext2D",
+                                      "stroke");
+        auto impl = V8CanvasRenderingContext2D::toImpl(info.Holder());
+        Path2D* path;
+        CanvasFillRule fillRule;
+        if (!ReadPathArguments(info, exceptionState, &path, &fillRule)) {
+            return;
+        }
+        if (path) {
+            impl->stroke(path);
+        } else {
+            impl->stroke();
+        }
+    }
+
+    void V8CanvasRenderingContext2D::clipMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        ExceptionState exceptionState(info.GetIsolate(), ExceptionState::ExecutionContext, "CanvasRenderingContext2D",
+                                      "clip");
+        auto impl = V8CanvasRenderingContext2D::toImpl(info.Holder());
+        Path2D* path;
+        CanvasFillRule fillRule;
+        if (!ReadPathArguments(info, exceptionState, &path, &fillRule)) {
+            return;
+        }
+        if (path) {
+            impl->clip(path, fillRule);
+        } else {
+            impl->clip(fillRule);
+        }
+    }
+
+    void V8CanvasRenderingContext2D::fillTextMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto isolate = info.GetIsolate();
+        ExceptionState exceptionState(isolate, ExceptionState::ExecutionContext, "CanvasRenderingContext2D",
+                                      "fillText");
+        auto impl = V8CanvasRenderingContext2D::toImpl(info.Holder());
+        if (info.Length() < 3) {
+            exceptionState.throwTypeError(ExceptionMessages::NotEnoughArguments(3, info.Length()));
+            return;
+        }
+        auto text = ToStdString(isolate, info[0], exceptionState);
+        auto x = ToFloat(isolate, info[1], exceptionState);
+        auto y = ToFloat(isolate, info[2], exceptionState);
+        auto maxWidth = info.Length() > 3 && !info[3]->IsUndefined() ?
+                        ToFloat(isolate, info[3], exceptionState) : INFINITY;
+        if (exceptionState.hadException()) {
+            return;
+        }
+        impl->fillText(text, x, y, maxWidth);
+    }
+
+    void V8CanvasRenderingContext2D::measureTextMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto isolate = info.GetIsolate();
+        ExceptionState exceptionState(isolate, ExceptionState::ExecutionContext, "CanvasRenderingContext2D",
+                                      "measureText");
+        auto impl = V8CanvasRenderingContext2D::toImpl(info.Holder());
+        if (info.Length() < 1) {
+            exceptionState.throwTypeError(ExceptionMessages::NotEnoughArguments(1, info.Length()));
+            return;
+        }
+        auto text = ToStdString(isolate, info[0], exceptionState);
+        if (exceptionState.hadException()) {
+            return;
+        }
+        auto width = impl->measureText(text);
+        auto env = Environment::GetCurrent(isolate);
+        auto metrics = env->makeObject();
+        env->setObjectProperty(metrics, Atom::WIDTH, static_cast<double>(width), true);
+        SetReturnValue(info, metrics);
+    }
+
+    /**
+     * Reads the image argument at the given index. Returns false if the argument is not an Image, or stores nullptr
+     * to image if the image has been disposed.
+     */
+    static bool ReadImageArgument(const v8::FunctionCallbackInfo<v8::Value>& info, int index,
+                                  ExceptionState& exceptionState, CanvasImageSource** image) {
+        if (!V8Binding::HasInstance(info.GetIsolate(), &V8Image::wrapperTypeInfo, info[index])) {
+            exceptionState.throwTypeError(ExceptionMessages::ArgumentNullOrIncorrectType(index + 1, "Image"));
+            return false;
+        }
+        *image = V8Image::toImpl(v8::Local<v8::Object>::Cast(info[index]));
+        return true;
+    }
+
+    void V8CanvasRenderingContext2D::drawImageMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto isolate = info.GetIsolate();
+        ExceptionState exceptionState(isolate, ExceptionState::ExecutionContext, "CanvasRenderingContext2D",
+                                      "drawImage");
+        auto impl = V8CanvasRenderingContext2D::toImpl(info.Holder());
+        auto length = info.Length();
+        if (length != 3 && length != 5 && length < 9) {
+            exceptionState.throwTypeError("Valid arities are: [3, 5, 9], but " + std::to_string(length) +
+                                          " arguments provided.");
+            return;
+        }
+        if (!V8Binding::HasInstance(isolate, &V8Image::wrapperTypeInfo, info[0])) {
+            exceptionState.throwTypeError(ExceptionMessages::ArgumentNullOrIncorrectType(1, "Image"));
+            return;
+        }
+        float values[8];
+        for (int i = 1; i < length && i < 9; i++) {
+            values[i - 1] = ToFloat(isolate, info[i], exceptionState);
+        }
+        if (exceptionState.hadException()) {
+            return;
+        }
+        // Look up the image after the conversions, a valueOf() of the arguments may have disposed it.
+        CanvasImageSource* image = V8Image::toImpl(v8::Local<v8::Object>::Cast(info[0]));
         if (!image) {
             return;
         }
-        if (args.Length() == 3) {
-            context->drawImage(image, env->toFloat(args[1]), env->toFloat(args[2]));
+        if (length == 3) {
+            impl->drawImage(image, values[0], values[1]);
+        } else if (length == 5) {
+            impl->drawImage(image, values[0], values[1], values[2], values[3]);
+        } else {
+            impl->drawImage(image, values[0], values[1], values[2], values[3], values[4], values[5], values[6],
+                            values[7]);
+        }
+    }
+
+    static void* GetTypedArrayData(v8::Local<v8::TypedArray> array) {
+        auto contents = array->Buffer()->GetContents();
+        return static_cast<char*>(contents.Data()) + array->ByteOffset();
+    }
+
+    void V8CanvasRenderingContext2D::drawImageBatchMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        ExceptionState exceptionState(info.GetIsolate(), ExceptionState::ExecutionContext, "CanvasRenderingContext2D",
+                                      "drawImageBatch");
+        auto impl = V8CanvasRenderingContext2D::toImpl(info.Holder());
+        if (info.Length() < 3) {
+            exceptionState.throwTypeError(ExceptionMessages::NotEnoughArguments(3, info.Length()));
             return;
         }
-        if (args.Length() == 5) {
-            context->drawImage(image, env->toFloat(args[1]), env->toFloat(args[2]), env->toFloat(args[3]),
-                               env->toFloat(args[4]));
+        CanvasImageSource* image;
+        if (!ReadImageArgument(info, 0, exceptionState, &image)) {
             return;
         }
-        context->drawImage(image, env->toFloat(args[1]), env->toFloat(args[2]), env->toFloat(args[3]),
-                           env->toFloat(args[4]), env->toFloat(args[5]), env->toFloat(args[6]), env->toFloat(args[7]),
-                           env->toFloat(args[8]));
+        if (!info[1]->IsFloat32Array()) {
+            exceptionState.throwTypeError(ExceptionMessages::ArgumentNullOrIncorrectType(2, "Float32Array"));
+            return;
+        }
+        if (!info[2]->IsFloat32Array()) {
+            exceptionState.throwTypeError(ExceptionMessages::ArgumentNullOrIncorrectType(3, "Float32Array"));
+            return;
+        }
+        if (info.Length() > 3 && !info[3]->IsUndefined() && !info[3]->IsUint32Array()) {
+            exceptionState.throwTypeError(ExceptionMessages::ArgumentNullOrIncorrectType(4, "Uint32Array"));
+            return;
+        }
+        if (!image) {
+            return;
+        }
+        auto transforms = v8::Local<v8::Float32Array>::Cast(info[1]);
+        auto srcRects = v8::Local<v8::Float32Array>::Cast(info[2]);
+        auto count = std::min(transforms->Length(), srcRects->Length()) / 4;
+        const SkColor* colors = nullptr;
+        if (info.Length() > 3 && info[3]->IsUint32Array()) {
+            auto colorArray = v8::Local<v8::Uint32Array>::Cast(info[3]);
+            count = std::min(count, colorArray->Length());
+            colors = static_cast<const SkColor*>(GetTypedArrayData(colorArray));
+        }
+        if (count == 0) {
+            return;
+        }
+        impl->drawImageBatch(image, static_cast<const float*>(GetTypedArrayData(transforms)),
+                             static_cast<const float*>(GetTypedArrayData(srcRects)), colors, static_cast<int>(count));
     }
 
-    static void constructor(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    void V8CanvasRenderingContext2D::getImageDataMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto isolate = info.GetIsolate();
+        ExceptionState exceptionState(isolate, ExceptionState::ExecutionContext, "CanvasRenderingContext2D",
+                                      "getImageData");
+        auto impl = V8CanvasRenderingContext2D::toImpl(info.Holder());
+        if (info.Length() < 4) {
+            exceptionState.throwTypeError(ExceptionMessages::NotEnoughArguments(4, info.Length()));
+            return;
+        }
+        auto x = ToInt32(isolate, info[0], exceptionState);
+        auto y = ToInt32(isolate, info[1], exceptionState);
+        auto width = ToInt32(isolate, info[2], exceptionState);
+        auto height = ToInt32(isolate, info[3], exceptionState);
+        if (exceptionState.hadException()) {
+            return;
+        }
+        if (width == 0 || height == 0) {
+            exceptionState.throwIndexSizeError(std::string("The source ") + (width == 0 ? "width" : "height") +
+                                               " is 0.");
+            return;
+        }
+        // Normalize the rectangle in 64 bits, negating INT_MIN or moving the origin may not fit in an int.
+        int64_t left = x, top = y, right = static_cast<int64_t>(x) + width, bottom = static_cast<int64_t>(y) + height;
+        if (left > right) {
+            std::swap(left, right);
+        }
+        if (top > bottom) {
+            std::swap(top, bottom);
+        }
+        const int64_t maxInt = std::numeric_limits<int>::max();
+        const int64_t minInt = std::numeric_limits<int>::min();
+        // The pixels must also fit in a typed array, whose length is limited to a positive int.
+        if (left < minInt || right > maxInt || top < minInt || bottom > maxInt ||
+            (right - left) * (bottom - top) > maxInt / 4) {
+            exceptionState.throwIndexSizeError("The source rectangle is out of the allowed range.");
+            return;
+        }
+        x = static_cast<int>(left);
+        y = static_cast<int>(top);
+        width = static_cast<int>(right - left);
+        height = static_cast<int>(bottom - top);
+        size_t byteSize = static_cast<size_t>(width) * height * 4;
+        // The pixels are converted straight into the backing store of the returned ImageData.
+        auto env = Environment::GetCurrent(isolate);
+        auto arrayBuffer = env->makeArrayBuffer(byteSize);
+        if (!impl->getImageData(x, y, width, height, arrayBuffer->GetContents().Data())) {
+            SetReturnValueNull(info);
+            return;
+        }
+        auto data = v8::Uint8ClampedArray::New(arrayBuffer, 0, byteSize);
+        auto ImageData = env->readGlobalFunction("ImageData");
+        auto result = env->newInstance(ImageData, data, env->makeValue(width), env->makeValue(height)).ToLocalChecked();
+        SetReturnValue(info, result);
+    }
+
+    void V8CanvasRenderingContext2D::putImageDataMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto isolate = info.GetIsolate();
+        ExceptionState exceptionState(isolate, ExceptionState::ExecutionContext, "CanvasRenderingContext2D",
+                                      "putImageData");
+        auto impl = V8CanvasRenderingContext2D::toImpl(info.Holder());
+        if (info.Length() < 3) {
+            exceptionState.throwTypeError(ExceptionMessages::NotEnoughArguments(3, info.Length()));
+            return;
+        }
+        if (!info[0]->IsObject()) {
+            exceptionState.throwTypeError(ExceptionMessages::ArgumentNullOrIncorrectType(1, "ImageData"));
+            return;
+        }
+        if (info.Length() != 3 && info.Length() < 7) {
+            exceptionState.throwTypeError(ExceptionMessages::InvalidArity("[3, 7]", info.Length()));
+            return;
+        }
+        auto env = Environment::GetCurrent(isolate);
+        auto imageData = v8::Local<v8::Object>::Cast(info[0]);
+        auto width = env->getInt(imageData, Atom::WIDTH);
+        auto height = env->getInt(imageData, Atom::HEIGHT);
+        auto maybeData = env->getObject(imageData, Atom::DATA);
+        if (maybeData.IsEmpty() || !maybeData.ToLocalChecked()->IsUint8ClampedArray() || width <= 0 || height <= 0) {
+            exceptionState.throwTypeError(ExceptionMessages::ArgumentNullOrIncorrectType(1, "ImageData"));
+            return;
+        }
+        auto data = v8::Local<v8::Uint8ClampedArray>::Cast(maybeData.ToLocalChecked());
+        if (data->ByteLength() < static_cast<size_t>(width) * height * 4) {
+            exceptionState.throwRangeError("The input data length is less than (4 * width * height).");
+            return;
+        }
+        auto dx = ToInt32(isolate, info[1], exceptionState);
+        auto dy = ToInt32(isolate, info[2], exceptionState);
+        int dirtyX = 0, dirtyY = 0, dirtyWidth = width, dirtyHeight = height;
+        if (info.Length() >= 7) {
+            dirtyX = ToInt32(isolate, info[3], exceptionState);
+            dirtyY = ToInt32(isolate, info[4], exceptionState);
+            dirtyWidth = ToInt32(isolate, info[5], exceptionState);
+            dirtyHeight = ToInt32(isolate, info[6], exceptionState);
+        }
+        if (exceptionState.hadException()) {
+            return;
+        }
+        impl->putImageData(GetTypedArrayData(data), width, height, dx, dy, dirtyX, dirtyY, dirtyWidth, dirtyHeight);
+    }
+
+    void V8CanvasRenderingContext2D::executeCommandsMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto isolate = info.GetIsolate();
+        ExceptionState exceptionState(isolate, ExceptionState::ExecutionContext, "CanvasRenderingContext2D",
+                                      "executeCommands");
+        auto impl = V8CanvasRenderingContext2D::toImpl(info.Holder());
+        if (!info[0]->IsFloat32Array() || !info[2]->IsArray() || !info[3]->IsArray()) {
+            exceptionState.throwTypeError("invalid arguments.");
+            return;
+        }
+        auto commands = v8::Local<v8::Float32Array>::Cast(info[0]);
+        auto count = ToInt32(isolate, info[1], exceptionState);
+        if (exceptionState.hadException()) {
+            return;
+        }
+        auto length = std::min(static_cast<size_t>(count), commands->Length());
+        auto context = isolate->GetCurrentContext();
+        auto imageArray = v8::Local<v8::Array>::Cast(info[2]);
+        // Reading the elements may run getters, which may dispose the images. Only keep their wrappers here and resolve
+        // them once all the script code has run.
+        std::vector<v8::Local<v8::Value>> imageObjects;
+        auto imageCount = imageArray->Length();
+        imageObjects.reserve(imageCount);
+        for (uint32_t i = 0; i < imageCount; i++) {
+            v8::Local<v8::Value> value;
+            if (!imageArray->Get(context, i).ToLocal(&value)) {
+                return;
+            }
+            imageObjects.push_back(value);
+        }
+        auto textArray = v8::Local<v8::Array>::Cast(info[3]);
+        std::vector<std::string> texts;
+        auto textCount = textArray->Length();
+        texts.reserve(textCount);
+        for (uint32_t i = 0; i < textCount; i++) {
+            v8::Local<v8::Value> value;
+            if (!textArray->Get(context, i).ToLocal(&value)) {
+                return;
+            }
+            texts.push_back(ToStdString(isolate, value, exceptionState));
+            if (exceptionState.hadException()) {
+                return;
+            }
+        }
+        // Resolve the image objects once per buffer, the commands refer to them by index.
+        std::vector<CanvasImageSource*> images;
+        images.reserve(imageObjects.size());
+        for (const auto& value : imageObjects) {
+            CanvasImageSource* image = V8Image::toImplWithTypeCheck(isolate, value);
+            if (!image) {
+                exceptionState.throwTypeError("invalid image.");
+                return;
+            }
+            images.push_back(image);
+        }
+        auto data = static_cast<const float*>(GetTypedArrayData(commands));
+        if (!impl->executeCommands(data, length, images.data(), images.size(), texts.data(), texts.size())) {
+            exceptionState.throwRangeError("malformed commands.");
+        }
+    }
+
+    CanvasRenderingContext2D* V8CanvasRenderingContext2D::toImplWithTypeCheck(v8::Isolate* isolate,
+                                                                             v8::Local<v8::Value> value) {
+        return V8Binding::HasInstance(isolate, &wrapperTypeInfo, value) ?
+               toImpl(v8::Local<v8::Object>::Cast(value)) : nullptr;
+    }
+
+    static void parseFontMethod(const v8::FunctionCallbackInfo<v8::Value>& args) {
         auto env = Environment::GetCurrent(args);
-        v8::HandleScope scope(env->isolate());
-        if (!args[0]->IsExternal()) {
-            env->throwError(ErrorType::TYPE_ERROR, "Illegal constructor");
+        CanvasFont font;
+        if (!FontManager::GetInstance()->parseFont(env->toStdString(args[0]), &font)) {
+            args.GetReturnValue().SetNull();
             return;
         }
-        auto external = v8::Local<v8::External>::Cast(args[0]);
-        auto context = reinterpret_cast<CanvasRenderingContext2D*>(external->Value());
-        auto self = args.This();
-        self->SetAlignedPointerInInternalField(0, context);
+        args.GetReturnValue().Set(env->makeString(font.text).ToLocalChecked());
+    }
+
+    static void parseColorMethod(const v8::FunctionCallbackInfo<v8::Value>& args) {
+        auto env = Environment::GetCurrent(args);
+        SkColor color;
+        if (!ParseCSSColor(env->toStdString(args[0]), &color)) {
+            args.GetReturnValue().SetNull();
+            return;
+        }
+        args.GetReturnValue().Set(static_cast<uint32_t>(color));
     }
 
     void V8CanvasRenderingContext2D::install(v8::Local<v8::Object> parent, Environment* env) {
-        auto classTemplate = env->makeFunctionTemplate(constructor);
-        auto prototypeTemplate = classTemplate->PrototypeTemplate();
-        env->setTemplateProperty(prototypeTemplate, "drawImage", drawImageMethod);
-        env->attachClass(parent, "CanvasRenderingContext2D", classTemplate);
+        auto cyderScope = env->readGlobalObject("cyder");
+        env->setObjectProperty(cyderScope, "parseColor", parseColorMethod);
+        env->setObjectProperty(cyderScope, "parseFont", parseFontMethod);
     }
-}
\ No newline at end of file
+
+    static const AccessorConfiguration V8CanvasRenderingContext2DAccessors[] = {
+            {"globalAlpha",              V8CanvasRenderingContext2D::globalAlphaAttributeGetterCallback,
+                                         V8CanvasRenderingContext2D::globalAlphaAttributeSetterCallback,
+                                         v8::None, InstallOnPrototype},
+            {"globalCompositeOperation", V8CanvasRenderingContext2D::globalCompositeOperationAttributeGetterCallback,
+                                         V8CanvasRenderingContext2D::globalCompositeOperationAttributeSetterCallback,
+                                         v8::None, InstallOnPrototype},
+            {"imageSmoothingEnabled",    V8CanvasRenderingContext2D::imageSmoothingEnabledAttributeGetterCallback,
+                                         V8CanvasRenderingContext2D::imageSmoothingEnabledAttributeSetterCallback,
+                                         v8::None, InstallOnPrototype},
+            {"fillStyle",                V8CanvasRenderingContext2D::fillStyleAttributeGetterCallback,
+                                         V8CanvasRenderingContext2D::fillStyleAttributeSetterCallback,
+                                         v8::None, InstallOnPrototype},
+            {"strokeStyle",              V8CanvasRenderingContext2D::strokeStyleAttributeGetterCallback,
+                                         V8CanvasRenderingContext2D::strokeStyleAttributeSetterCallback,
+                                         v8::None, InstallOnPrototype},
+            {"lineWidth",                V8CanvasRenderingContext2D::lineWidthAttributeGetterCallback,
+                                         V8CanvasRenderingContext2D::lineWidthAttributeSetterCallback,
+                                         v8::None, InstallOnPrototype},
+            {"font",                     V8CanvasRenderingContext2D::fontAttributeGetterCallback,
+                                         V8CanvasRenderingContext2D::fontAttributeSetterCallback,
+                                         v8::None, InstallOnPrototype},
+            {"textAlign",                V8CanvasRenderingContext2D::textAlignAttributeGetterCallback,
+                                         V8CanvasRenderingContext2D::textAlignAttributeSetterCallback,
+                                         v8::None, InstallOnPrototype},
+            {"textBaseline",             V8CanvasRenderingContext2D::textBaselineAttributeGetterCallback,
+                                         V8CanvasRenderingContext2D::textBaselineAttributeSetterCallback,
+                                         v8::None, InstallOnPrototype}
+    };
+
+    static const MethodConfiguration V8CanvasRenderingContext2DMethods[] = {
+            {"save",             V8CanvasRenderingContext2D::saveMethodCallback,             0, v8::None, InstallOnPrototype},
+            {"restore",          V8CanvasRenderingContext2D::restoreMethodCallback,          0, v8::None, InstallOnPrototype},
+            {"translate",        V8CanvasRenderingContext2D::translateMethodCallback,        2, v8::None, InstallOnPrototype},
+            {"rotate",           V8CanvasRenderingContext2D::rotateMethodCallback,           1, v8::None, InstallOnPrototype},
+            {"scale",            V8CanvasRenderingContext2D::scaleMethodCallback,            2, v8::None, InstallOnPrototype},
+            {"transform",        V8CanvasRenderingContext2D::transformMethodCallback,        6, v8::None, InstallOnPrototype},
+            {"setTransform",     V8CanvasRenderingContext2D::setTransformMethodCallback,     6, v8::None, InstallOnPrototype},
+            {"resetTransform",   V8CanvasRenderingContext2D::resetTransformMethodCallback,   0, v8::None, InstallOnPrototype},
+            {"beginPath",        V8CanvasRenderingContext2D::beginPathMethodCallback,        0, v8::None, InstallOnPrototype},
+            {"closePath",        V8CanvasRenderingContext2D::closePathMethodCallback,        0, v8::None, InstallOnPrototype},
+            {"moveTo",           V8CanvasRenderingContext2D::moveToMethodCallback,           2, v8::None, InstallOnPrototype},
+            {"lineTo",           V8CanvasRenderingContext2D::lineToMethodCallback,           2, v8::None, InstallOnPrototype},
+            {"quadraticCurveTo", V8CanvasRenderingContext2D::quadraticCurveToMethodCallback, 4, v8::None, InstallOnPrototype},
+            {"bezierCurveTo",    V8CanvasRenderingContext2D::bezierCurveToMethodCallback,    6, v8::None, InstallOnPrototype},
+            {"arc",              V8CanvasRenderingContext2D::arcMethodCallback,              5, v8::None, InstallOnPrototype},
+            {"rect",             V8CanvasRenderingContext2D::rectMethodCallback,             4, v8::None, InstallOnPrototype},
+            {"fill",             V8CanvasRenderingContext2D::fillMethodCallback,             0, v8::None, InstallOnPrototype},
+            {"stroke",           V8CanvasRenderingContext2D::strokeMethodCallback,           0, v8::None, InstallOnPrototype},
+            {"clip",             V8CanvasRenderingContext2D::clipMethodCallback,             0, v8::None, InstallOnPrototype},
+            {"fillText",         V8CanvasRenderingContext2D::fillTextMethodCallback,         3, v8::None, InstallOnPrototype},
+            {"measureText",      V8CanvasRenderingContext2D::measureTextMethodCallback,      1, v8::None, InstallOnPrototype},
+            {"drawImage",        V8CanvasRenderingContext2D::drawImageMethodCallback,        3, v8::None, InstallOnPrototype},
+            {"drawImageBatch",   V8CanvasRenderingContext2D::drawImageBatchMethodCallback,   3, v8::None, InstallOnPrototype},
+            {"getImageData",     V8CanvasRenderingContext2D::getImageDataMethodCallback,     4, v8::None, InstallOnPrototype},
+            {"putImageData",     V8CanvasRenderingContext2D::putImageDataMethodCallback,     3, v8::None, InstallOnPrototype},
+            {"executeCommands",  V8CanvasRenderingContext2D::executeCommandsMethodCallback,  4, v8::None, InstallOnPrototype}
+    };
+
+    const WrapperTypeInfo V8CanvasRenderingContext2D::wrapperTypeInfo = {
+            nullptr, "CanvasRenderingContext2D",
+            V8CanvasRenderingContext2D::constructorCallback, 0,
+            V8CanvasRenderingContext2DAccessors, 9,
+            V8CanvasRenderingContext2DMethods, 26,
+            nullptr, 0,
+            nullptr, 0};
+
+    const WrapperTypeInfo& CanvasRenderingContext2D::wrapperTypeInfo = V8CanvasRenderingContext2D::wrapperTypeInfo;
+}
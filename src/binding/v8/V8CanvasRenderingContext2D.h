@@ -27,14 +27,74 @@
 #ifndef CYDER_V8CANVASRENDERINGCONTEXT2D_H
 #define CYDER_V8CANVASRENDERINGCONTEXT2D_H
 
-#include <v8.h>
+#include "binding/V8Binding.h"
 #include "binding/Environment.h"
+#include "modules/canvas2d/CanvasRenderingContext2D.h"
 
 namespace cyder {
 
     class V8CanvasRenderingContext2D {
     public:
-        static void install(v8::Local <v8::Object> parent, Environment* env);
+
+        static CanvasRenderingContext2D* toImpl(v8::Local<v8::Object> object) {
+            return ToScriptWrappable(object)->toImpl<CanvasRenderingContext2D>();
+        }
+
+        static CanvasRenderingContext2D* toImplWithTypeCheck(v8::Isolate* isolate, v8::Local<v8::Value> value);
+        static const WrapperTypeInfo wrapperTypeInfo;
+
+        /**
+         * Installs the parseColor() and parseFont() helpers on the cyder object.
+         */
+        static void install(v8::Local<v8::Object> parent, Environment* env);
+
+        static void constructorCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+
+        static void globalAlphaAttributeGetterCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void globalAlphaAttributeSetterCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void globalCompositeOperationAttributeGetterCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void globalCompositeOperationAttributeSetterCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void imageSmoothingEnabledAttributeGetterCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void imageSmoothingEnabledAttributeSetterCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void fillStyleAttributeGetterCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void fillStyleAttributeSetterCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void strokeStyleAttributeGetterCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void strokeStyleAttributeSetterCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void lineWidthAttributeGetterCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void lineWidthAttributeSetterCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void fontAttributeGetterCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void fontAttributeSetterCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void textAlignAttributeGetterCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void textAlignAttributeSetterCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void textBaselineAttributeGetterCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void textBaselineAttributeSetterCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+
+        static void saveMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void restoreMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void translateMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void rotateMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void scaleMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void transformMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void setTransformMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void resetTransformMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void beginPathMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void closePathMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void moveToMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void lineToMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void quadraticCurveToMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void bezierCurveToMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void arcMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void rectMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void fillMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void strokeMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void clipMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void fillTextMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void measureTextMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void drawImageMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void drawImageBatchMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void getImageDataMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void putImageDataMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void executeCommandsMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
     };
 
 }
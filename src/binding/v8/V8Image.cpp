@@ -26,11 +26,39 @@
 
 
 #include "V8Image.h"
+#include <cstring>
+#include <memory>
+#include <vector>
+#include "base/ThreadPool.h"
+#include "binding/ArrayBufferAllocator.h"
+#include "binding/Environment.h"
+#include "binding/ObjectConstructor.h"
 #include "utils/Base64.h"
 #include "utils/SkUnref.h"
 
 namespace cyder {
 
+    namespace {
+        /**
+         * An encoding of one or more images in progress. The images are encoded concurrently on the thread pool, and
+         * the callback is invoked on the main thread once all of them are done.
+         */
+        struct EncodeRequest {
+            Environment* env;
+            v8::UniquePersistent<v8::Function> callback;
+            ImageFormat format;
+            double quality;
+            bool batch;
+            /**
+             * The snapshots of the images to encode, they share the pixels of the images passed in by scripts so the
+             * scripts are free to dispose those images in the meantime.
+             */
+            std::vector<std::unique_ptr<Image>> images;
+            std::vector<sk_sp<SkData>> results;
+            size_t remaining;
+        };
+    }
+
     static std::string formatImageMimeType(const std::string& mimeType) {
         auto type = StringUtil::ToLowerCase(mimeType);
         if (type != "image/jpeg" && type != "image/webp") {
@@ -51,179 +79,406 @@ namespace cyder {
         return format;
     }
 
-    static void disposeMethod(const v8::FunctionCallbackInfo<v8::Value>& args) {
-        auto env = Environment::GetCurrent(args);
-        auto self = args.This();
-        auto image = static_cast<SkImage*>(self->GetAlignedPointerFromInternalField(0));
-        if (!image) {
-            return;
+    /**
+     * Returns the image of the holder, throws an error if the image has been disposed.
+     */
+    static Image* toValidImpl(const v8::FunctionCallbackInfo<v8::Value>& info, ExceptionState& exceptionState) {
+        auto impl = V8Image::toImpl(info.Holder());
+        if (!impl) {
+            exceptionState.throwError("The image has been disposed.");
         }
-        env->setObjectProperty(self, "width", 0);
-        env->setObjectProperty(self, "height", 0);
-        self->SetAlignedPointerInInternalField(0, nullptr);
-        auto weakHandle = static_cast<WeakHandle*>(self->GetAlignedPointerFromInternalField(1));
-        self->SetAlignedPointerInInternalField(1, nullptr);
-        delete weakHandle;
-        SkSafeUnref(image);
+        return impl;
     }
 
-    static void encodeMethod(const v8::FunctionCallbackInfo<v8::Value>& args) {
-        auto env = Environment::GetCurrent(args);
-        auto image = getInternalImage(args.This(), env);
-        if (!image) {
-            return;
+    static void freeArrayBufferContents(const void*, void* context) {
+        auto contents = static_cast<v8::ArrayBuffer::Contents*>(context);
+        ArrayBufferAllocator::GetInstance()->Free(contents->Data(), contents->ByteLength());
+        delete contents;
+    }
+
+    /**
+     * Takes over the backing store of the array buffer and detaches it from javascript, returns nullptr if the buffer
+     * cannot be detached, e.g. it is already owned by the native side.
+     */
+    static sk_sp<SkData> transferArrayBuffer(const v8::Local<v8::ArrayBuffer>& arrayBuffer, size_t offset,
+                                             size_t length) {
+        if (arrayBuffer->IsExternal() || !arrayBuffer->IsNeuterable()) {
+            return nullptr;
         }
-        std::string type = formatImageMimeType(env->toStdString(args[0]));
-        auto quality = args[1]->IsUndefined() ? -1 : env->toDouble(args[1]);
-        auto bytes = image->encode(toImageFormat(type), quality);
-        if (!bytes || bytes->size() == 0) {
-            args.GetReturnValue().Set(env->makeNull());
-            return;
+        auto contents = new v8::ArrayBuffer::Contents(arrayBuffer->Externalize());
+        arrayBuffer->Neuter();
+        auto data = reinterpret_cast<char*>(contents->Data());
+        return SkData::MakeWithProc(data + offset, length, freeArrayBufferContents, contents);
+    }
+
+    static Image* createFromImageData(const v8::Local<v8::Object>& imageData, bool transparent, bool transferPixels,
+                                      Environment* env) {
+        auto width = env->getInt(imageData, Atom::WIDTH);
+        auto height = env->getInt(imageData, Atom::HEIGHT);
+        if (width <= 0 || height <= 0) {
+            return nullptr;
         }
-        auto arrayBuffer = env->makeArrayBuffer(bytes->writable_data(), bytes->size());
-        env->bind(arrayBuffer, SkUnref::Wrap(bytes));
-        args.GetReturnValue().Set(arrayBuffer);
+        auto maybeData = env->getObject(imageData, Atom::DATA);
+        if (maybeData.IsEmpty() || !maybeData.ToLocalChecked()->IsArrayBufferView()) {
+            return nullptr;
+        }
+        auto view = v8::Local<v8::ArrayBufferView>::Cast(maybeData.ToLocalChecked());
+        auto arrayBuffer = view->Buffer();
+        auto offset = view->ByteOffset();
+        auto length = static_cast<size_t>(width) * height * 4;
+        if (view->ByteLength() < length) {
+            return nullptr;
+        }
+        if (transferPixels) {
+            auto pixels = transferArrayBuffer(arrayBuffer, offset, length);
+            if (pixels) {
+                return Image::MakeFromPixels(std::move(pixels), width, height, transparent);
+            }
+        }
+        auto bytes = reinterpret_cast<char*>(arrayBuffer->GetContents().Data()) + offset;
+        return Image::MakeFromPixels(bytes, width, height, transparent);
     }
 
-    static void getImageDataMethod(const v8::FunctionCallbackInfo<v8::Value>& args) {
-        auto env = Environment::GetCurrent(args);
-        auto image = getInternalImage(args.This(), env);
-        if (!image) {
+    void V8Image::constructorCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto isolate = info.GetIsolate();
+        if (ConstructorScope::IsValid(isolate)) {
+            // Creating the boilerplate of the wrappers of native images.
+            SetReturnValue(info, info.Holder());
             return;
         }
-        auto x = env->toInt(args[0]);
-        auto y = env->toInt(args[1]);
-        auto width = env->toInt(args[2]);
-        auto height = env->toInt(args[3]);
-        size_t byteSize = static_cast<size_t>(width * height * 4);
-        if (byteSize == 0) {
-            args.GetReturnValue().Set(env->makeNull());
+        ExceptionState exceptionState(isolate, ExceptionState::ConstructionContext, "Image");
+        if (info.Length() < 1) {
+            exceptionState.throwTypeError(ExceptionMessages::NotEnoughArguments(1, info.Length()));
             return;
         }
-        auto arrayBuffer = env->makeArrayBuffer(byteSize);
-        auto buffer = arrayBuffer->GetContents().Data();
-        if (!image->readPixels(buffer, x, y, width, height)) {
-            args.GetReturnValue().Set(env->makeNull());
+        if (!info[0]->IsObject()) {
+            exceptionState.throwTypeError(ExceptionMessages::ArgumentNullOrIncorrectType(1, "ImageData"));
             return;
         }
-        auto data = v8::Uint8ClampedArray::New(arrayBuffer, 0, byteSize);
-        auto ImageData = env->readGlobalFunction("ImageData");
-        auto result = env->newInstance(ImageData, data, env->makeValue(width), env->makeValue(height)).ToLocalChecked();
-        args.GetReturnValue().Set(result);
-    }
-
-    static void makeSubsetMethod(const v8::FunctionCallbackInfo<v8::Value>& args) {
-        auto env = Environment::GetCurrent(args);
-        auto image = getInternalImage(args.This(), env);
-        if (!image) {
+        auto transparent = info[1]->IsUndefined() || ToBoolean(isolate, info[1], exceptionState);
+        auto transferPixels = ToBoolean(isolate, info[2], exceptionState);
+        if (exceptionState.hadException()) {
             return;
         }
-        auto x = env->toInt(args[0]);
-        auto y = env->toInt(args[1]);
-        auto width = env->toInt(args[2]);
-        auto height = env->toInt(args[3]);
-        auto sharePixels = args[4]->IsUndefined() ? true : env->toBoolean(args[4]);
-        auto subsetImage = image->makeSubset(x, y, width, height, sharePixels);
-        if (!subsetImage) {
-            args.GetReturnValue().Set(env->makeNull());
+        auto env = Environment::GetCurrent(isolate);
+        auto impl = createFromImageData(v8::Local<v8::Object>::Cast(info[0]), transparent, transferPixels, env);
+        if (!impl) {
+            exceptionState.throwTypeError("parameter 1 is invalid ImageData.");
             return;
         }
-        auto ImageClass = env->readGlobalFunction("Image");
-        auto imageObject = env->newInstance(ImageClass, env->makeExternal(subsetImage)).ToLocalChecked();
-        args.GetReturnValue().Set(imageObject);
+        auto wrapper = info.Holder();
+        impl->setWrapper(isolate, wrapper);
+        SetReturnValue(info, wrapper);
+    }
+
+    void V8Image::widthAttributeGetterCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto impl = V8Image::toImpl(info.Holder());
+        SetReturnValue(info, impl ? impl->width() : 0);
     }
 
+    void V8Image::heightAttributeGetterCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto impl = V8Image::toImpl(info.Holder());
+        SetReturnValue(info, impl ? impl->height() : 0);
+    }
 
-    static void toDataURLMethod(const v8::FunctionCallbackInfo<v8::Value>& args) {
-        auto env = Environment::GetCurrent(args);
-        auto image = getInternalImage(args.This(), env);
-        if (!image) {
+    void V8Image::transparentAttributeGetterCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto impl = V8Image::toImpl(info.Holder());
+        SetReturnValue(info, impl && impl->transparent());
+    }
+
+    void V8Image::disposeMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto impl = V8Image::toImpl(info.Holder());
+        if (!impl) {
             return;
         }
-        std::string mimeType = formatImageMimeType(env->toStdString(args[0]));
-        auto quality = args[1]->IsUndefined() ? -1 : env->toDouble(args[1]);
-        auto bytes = image->encode(toImageFormat(mimeType), quality);
+        // Deleting the image also releases the wrapper and the external memory reported to v8.
+        info.Holder()->SetAlignedPointerInInternalField(InternalFields::WrapperObjectIndex, nullptr);
+        delete impl;
+    }
+
+    /**
+     * Wraps the encoded bytes in an ArrayBuffer without copying them, returns null if there are no bytes. Takes the
+     * ownership of the bytes.
+     */
+    static v8::Local<v8::Value> makeEncodedBuffer(SkData* bytes, Environment* env) {
         if (!bytes || bytes->size() == 0) {
-            args.GetReturnValue().Set(env->makeString("data:,").ToLocalChecked());
+            SkSafeUnref(bytes);
+            return env->makeNull();
+        }
+        auto arrayBuffer = env->makeArrayBuffer(bytes->writable_data(), bytes->size());
+        env->bind(arrayBuffer, SkUnref::Wrap(bytes), bytes->size());
+        return arrayBuffer;
+    }
+
+    void V8Image::encodeMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto isolate = info.GetIsolate();
+        ExceptionState exceptionState(isolate, ExceptionState::ExecutionContext, "Image", "encode");
+        auto impl = toValidImpl(info, exceptionState);
+        if (!impl) {
             return;
         }
-        auto data = reinterpret_cast<char*>(bytes->writable_data());
-        auto textLength = Base64::EncodeLength(bytes->size());
-        auto base64Buffer = new char[textLength + 1];
-        Base64::Encode(data, bytes->size(), base64Buffer);
-        base64Buffer[textLength] = '\0';
-        std::string url = "data:" + mimeType + ";base64," + base64Buffer;
-        auto maybeURLObject = env->makeString(url);
-        SkSafeUnref(bytes);
-        if (maybeURLObject.IsEmpty()) {
-            args.GetReturnValue().Set(env->makeString("data:,").ToLocalChecked());
+        auto type = formatImageMimeType(ToStdString(isolate, info[0], exceptionState));
+        auto quality = info[1]->IsUndefined() ? -1 : ToDouble(isolate, info[1], exceptionState);
+        if (exceptionState.hadException()) {
             return;
         }
-        args.GetReturnValue().Set(maybeURLObject.ToLocalChecked());
+        auto bytes = impl->encode(toImageFormat(type), quality);
+        SetReturnValue(info, makeEncodedBuffer(bytes, Environment::GetCurrent(isolate)));
     }
 
-    static Image* createFromImageData(const v8::Local<v8::Object>& imageData, bool transparent, Environment* env) {
-        auto width = env->getInt(imageData, "width");
-        auto height = env->getInt(imageData, "height");
-        if (width == 0 || height == 0) {
-            return nullptr;
+    /**
+     * Passes the encoded images to the callback of the request, runs on the main thread.
+     */
+    static void completeEncode(EncodeRequest* request) {
+        auto env = request->env;
+        auto isolate = env->isolate();
+        v8::HandleScope scope(isolate);
+        v8::Context::Scope contextScope(env->context());
+        v8::TryCatch tryCatch(isolate);
+        auto callback = v8::Local<v8::Function>::New(isolate, request->callback);
+        request->callback.Reset();
+        v8::Local<v8::Value> result;
+        if (request->batch) {
+            auto count = static_cast<int>(request->results.size());
+            auto array = v8::Array::New(isolate, count);
+            for (int i = 0; i < count; i++) {
+                array->Set(env->context(), i, makeEncodedBuffer(request->results[i].release(), env)).FromJust();
+            }
+            result = array;
+        } else {
+            result = makeEncodedBuffer(request->results[0].release(), env);
         }
-        auto maybeData = env->getObject(imageData, "data");
-        if (maybeData.IsEmpty()) {
-            return nullptr;
+        if (env->call(callback, env->makeNull(), result).IsEmpty()) {
+            env->printStackTrace(tryCatch);
         }
-        auto maybeBuffer = env->getObject(maybeData.ToLocalChecked(), "buffer");
-        if (maybeBuffer.IsEmpty()) {
-            return nullptr;
+    }
+
+    /**
+     * Encodes the images of the request concurrently on the thread pool.
+     */
+    static void startEncode(const std::shared_ptr<EncodeRequest>& request) {
+        request->results.resize(request->images.size());
+        request->remaining = request->images.size();
+        if (request->remaining == 0) {
+            // Keep the callback asynchronous even if there is nothing to encode.
+            ThreadPool::Default()->post([]() {}, [request]() {
+                completeEncode(request.get());
+            });
+            return;
         }
-        auto buffer = maybeBuffer.ToLocalChecked();
-        if (!buffer->IsArrayBuffer()) {
+        for (size_t i = 0; i < request->images.size(); i++) {
+            ThreadPool::Default()->post([request, i]() {
+                // The pixels of an image are immutable, reading them from another thread is safe.
+                auto& image = request->images[i];
+                if (image) {
+                    request->results[i].reset(image->encode(request->format, request->quality));
+                    image.reset();
+                }
+            }, [request]() {
+                if (--request->remaining == 0) {
+                    completeEncode(request.get());
+                }
+            });
+        }
+    }
+
+    /**
+     * Reads the type, quality and callback arguments starting at the given index, returns nullptr if any of them is
+     * invalid.
+     */
+    static std::shared_ptr<EncodeRequest> makeEncodeRequest(const v8::FunctionCallbackInfo<v8::Value>& info, int index,
+                                                            bool batch, ExceptionState& exceptionState) {
+        auto isolate = info.GetIsolate();
+        auto type = formatImageMimeType(ToStdString(isolate, info[index], exceptionState));
+        auto quality = info[index + 1]->IsUndefined() ? -1 : ToDouble(isolate, info[index + 1], exceptionState);
+        if (exceptionState.hadException()) {
             return nullptr;
         }
-        auto arrayBuffer = v8::Local<v8::ArrayBuffer>::Cast(buffer);
-        auto bytes = arrayBuffer->GetContents().Data();
-        auto length = arrayBuffer->ByteLength();
-        if (length < width * height * 4) {
+        if (!info[index + 2]->IsFunction()) {
+            exceptionState.throwTypeError(ExceptionMessages::ArgumentNullOrIncorrectType(index + 3, "Function"));
             return nullptr;
         }
-        return Image::MakeFromPixels(bytes, width, height, transparent);
+        auto request = std::make_shared<EncodeRequest>();
+        request->env = Environment::GetCurrent(isolate);
+        request->callback.Reset(isolate, v8::Local<v8::Function>::Cast(info[index + 2]));
+        request->format = toImageFormat(type);
+        request->quality = quality;
+        request->batch = batch;
+        return request;
     }
 
-    static void constructor(const v8::FunctionCallbackInfo<v8::Value>& args) {
-        auto env = Environment::GetCurrent(args);
-        v8::HandleScope scope(env->isolate());
-        Image* image;
-        if (args[0]->IsExternal()) {
-            auto external = v8::Local<v8::External>::Cast(args[0]);
-            image = reinterpret_cast<Image*>(external->Value());
-        } else {
-            auto imageData = v8::Local<v8::Object>::Cast(args[0]);
-            auto transparent = args[1]->IsUndefined() ? true : env->toBoolean(args[1]);
-            image = createFromImageData(imageData, transparent, env);
+    /**
+     * Returns a new image sharing the pixels of the image, no pixels are copied.
+     */
+    static Image* makeSnapshot(Image* image) {
+        return image->makeSubset(0, 0, image->width(), image->height(), true);
+    }
+
+    void V8Image::encodeAsyncMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        ExceptionState exceptionState(info.GetIsolate(), ExceptionState::ExecutionContext, "Image", "encodeAsync");
+        auto impl = toValidImpl(info, exceptionState);
+        if (!impl) {
+            return;
+        }
+        auto request = makeEncodeRequest(info, 0, false, exceptionState);
+        if (!request) {
+            return;
+        }
+        request->images.emplace_back(makeSnapshot(impl));
+        startEncode(request);
+    }
+
+    void V8Image::encodeAllMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto isolate = info.GetIsolate();
+        ExceptionState exceptionState(isolate, ExceptionState::ExecutionContext, "Image", "encodeAll");
+        if (!info[0]->IsArray()) {
+            exceptionState.throwTypeError(ExceptionMessages::ArgumentNullOrIncorrectType(1, "Array"));
+            return;
+        }
+        auto request = makeEncodeRequest(info, 1, true, exceptionState);
+        if (!request) {
+            return;
+        }
+        auto context = isolate->GetCurrentContext();
+        auto array = v8::Local<v8::Array>::Cast(info[0]);
+        auto length = array->Length();
+        for (uint32_t i = 0; i < length; i++) {
+            v8::Local<v8::Value> value;
+            if (!array->Get(context, i).ToLocal(&value)) {
+                return;
+            }
+            if (!V8Binding::HasInstance(isolate, &wrapperTypeInfo, value)) {
+                exceptionState.throwTypeError("parameter 1 is not an array of Image.");
+                return;
+            }
+            auto image = V8Image::toImpl(v8::Local<v8::Object>::Cast(value));
             if (!image) {
-                env->throwError(ErrorType::TYPE_ERROR,
-                                "Failed to execute 'new Image()': parameter 1 is invalid ImageData.");
+                exceptionState.throwError("The image at index " + std::to_string(i) + " has been disposed.");
                 return;
             }
+            request->images.emplace_back(makeSnapshot(image));
+        }
+        startEncode(request);
+    }
+
+    void V8Image::getImageDataMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto isolate = info.GetIsolate();
+        ExceptionState exceptionState(isolate, ExceptionState::ExecutionContext, "Image", "getImageData");
+        auto impl = toValidImpl(info, exceptionState);
+        if (!impl) {
+            return;
+        }
+        if (info.Length() < 4) {
+            exceptionState.throwTypeError(ExceptionMessages::NotEnoughArguments(4, info.Length()));
+            return;
+        }
+        auto x = ToInt32(isolate, info[0], exceptionState);
+        auto y = ToInt32(isolate, info[1], exceptionState);
+        auto width = ToInt32(isolate, info[2], exceptionState);
+        auto height = ToInt32(isolate, info[3], exceptionState);
+        if (exceptionState.hadException()) {
+            return;
+        }
+        size_t byteSize = static_cast<size_t>(width * height * 4);
+        if (byteSize == 0) {
+            SetReturnValueNull(info);
+            return;
+        }
+        auto env = Environment::GetCurrent(isolate);
+        auto arrayBuffer = env->makeArrayBuffer(byteSize);
+        auto buffer = arrayBuffer->GetContents().Data();
+        if (!impl->readPixels(buffer, x, y, width, height)) {
+            SetReturnValueNull(info);
+            return;
+        }
+        auto data = v8::Uint8ClampedArray::New(arrayBuffer, 0, byteSize);
+        auto ImageData = env->readGlobalFunction("ImageData");
+        auto result = env->newInstance(ImageData, data, env->makeValue(width), env->makeValue(height)).ToLocalChecked();
+        SetReturnValue(info, result);
+    }
+
+    void V8Image::makeSubsetMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto isolate = info.GetIsolate();
+        ExceptionState exceptionState(isolate, ExceptionState::ExecutionContext, "Image", "makeSubset");
+        auto impl = toValidImpl(info, exceptionState);
+        if (!impl) {
+            return;
+        }
+        if (info.Length() < 4) {
+            exceptionState.throwTypeError(ExceptionMessages::NotEnoughArguments(4, info.Length()));
+            return;
+        }
+        auto x = ToInt32(isolate, info[0], exceptionState);
+        auto y = ToInt32(isolate, info[1], exceptionState);
+        auto width = ToInt32(isolate, info[2], exceptionState);
+        auto height = ToInt32(isolate, info[3], exceptionState);
+        auto sharePixels = info[4]->IsUndefined() || ToBoolean(isolate, info[4], exceptionState);
+        if (exceptionState.hadException()) {
+            return;
+        }
+        SetReturnValue(info, impl->makeSubset(x, y, width, height, sharePixels));
+    }
+
+    void V8Image::toDataURLMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto isolate = info.GetIsolate();
+        ExceptionState exceptionState(isolate, ExceptionState::ExecutionContext, "Image", "toDataURL");
+        auto impl = toValidImpl(info, exceptionState);
+        if (!impl) {
+            return;
+        }
+        auto mimeType = formatImageMimeType(ToStdString(isolate, info[0], exceptionState));
+        auto quality = info[1]->IsUndefined() ? -1 : ToDouble(isolate, info[1], exceptionState);
+        if (exceptionState.hadException()) {
+            return;
+        }
+        sk_sp<SkData> bytes(impl->encode(toImageFormat(mimeType), quality));
+        if (!bytes || bytes->size() == 0) {
+            SetReturnValue(info, ToV8(isolate, "data:,"));
+            return;
+        }
+        // Build the whole URL in one buffer and hand it to V8 as an external string, so the encoded text is written
+        // once and never copied into the V8 heap.
+        std::string prefix = "data:" + mimeType + ";base64,";
+        auto urlLength = prefix.size() + Base64::EncodeLength(bytes->size());
+        auto url = new char[urlLength];
+        memcpy(url, prefix.c_str(), prefix.size());
+        Base64::Encode(static_cast<const char*>(bytes->data()), bytes->size(), url + prefix.size());
+        bytes.reset();
+        auto maybeURLObject = Environment::GetCurrent(isolate)->makeExternalString(url, urlLength);
+        if (maybeURLObject.IsEmpty()) {
+            SetReturnValue(info, ToV8(isolate, "data:,"));
+            return;
         }
-        auto self = args.This();
-        self->SetAlignedPointerInInternalField(0, image);
-        env->setObjectProperty(self, "width", env->makeValue(image->width()));
-        env->setObjectProperty(self, "height", env->makeValue(image->height()));
-        env->setObjectProperty(self, "transparent", env->makeValue(image->transparent()), true);
-        auto handle = env->bind(self, image);
-        self->SetAlignedPointerInInternalField(1, handle);
+        SetReturnValue(info, maybeURLObject.ToLocalChecked());
     }
 
-    void V8Image::install(const v8::Local<v8::Object>& parent, Environment* env) {
-        auto classTemplate = env->makeFunctionTemplate(constructor);
-        auto prototypeTemplate = classTemplate->PrototypeTemplate();
-        env->setTemplateProperty(prototypeTemplate, "dispose", disposeMethod);
-        env->setTemplateProperty(prototypeTemplate, "encode", encodeMethod);
-        env->setTemplateProperty(prototypeTemplate, "getImageData", getImageDataMethod);
-        env->setTemplateProperty(prototypeTemplate, "makeSubset", makeSubsetMethod);
-        env->setTemplateProperty(prototypeTemplate, "toDataURL", toDataURLMethod);
-        env->attachClass(parent, "Image", classTemplate, 2);
+    Image* V8Image::toImplWithTypeCheck(v8::Isolate* isolate, v8::Local<v8::Value> value) {
+        return V8Binding::HasInstance(isolate, &wrapperTypeInfo, value) ?
+               toImpl(v8::Local<v8::Object>::Cast(value)) : nullptr;
     }
 
-}
\ No newline at end of file
+    static const AccessorConfiguration V8ImageAccessors[] = {
+            {"width",       V8Image::widthAttributeGetterCallback,       nullptr, v8::ReadOnly, InstallOnPrototype},
+            {"height",      V8Image::heightAttributeGetterCallback,      nullptr, v8::ReadOnly, InstallOnPrototype},
+            {"transparent", V8Image::transparentAttributeGetterCallback, nullptr, v8::ReadOnly, InstallOnPrototype}
+    };
+
+    static const MethodConfiguration V8ImageMethods[] = {
+            {"dispose",      V8Image::disposeMethodCallback,      0, v8::None, InstallOnPrototype},
+            {"encode",       V8Image::encodeMethodCallback,       0, v8::None, InstallOnPrototype},
+            {"encodeAsync",  V8Image::encodeAsyncMethodCallback,  3, v8::None, InstallOnPrototype},
+            {"getImageData", V8Image::getImageDataMethodCallback, 4, v8::None, InstallOnPrototype},
+            {"makeSubset",   V8Image::makeSubsetMethodCallback,   4, v8::None, InstallOnPrototype},
+            {"toDataURL",    V8Image::toDataURLMethodCallback,    0, v8::None, InstallOnPrototype},
+            {"encodeAll",    V8Image::encodeAllMethodCallback,    4, v8::None, InstallOnClass}
+    };
+
+    const WrapperTypeInfo V8Image::wrapperTypeInfo = {nullptr, "Image",
+                                                      V8Image::constructorCallback, 1,
+                                                      V8ImageAccessors, 3,
+                                                      V8ImageMethods, 7,
+                                                      nullptr, 0,
+                                                      nullptr, 0};
+
+    const WrapperTypeInfo& Image::wrapperTypeInfo = V8Image::wrapperTypeInfo;
+}
@@ -24,28 +24,41 @@
 //
 //////////////////////////////////////////////////////////////////////////////////////
 
-
 #ifndef CYDER_V8IMAGE_H
 #define CYDER_V8IMAGE_H
 
-#include <v8.h>
-#include "binding/Environment.h"
+#include "binding/V8Binding.h"
 #include "modules/image/Image.h"
 
 namespace cyder {
 
-    inline Image* getInternalImage(const v8::Local<v8::Object>& self, Environment* env) {
-        auto image = static_cast<Image*>(self->GetAlignedPointerFromInternalField(0));
-        if (!image) {
-            env->throwError(ErrorType::ERROR, "Invalid Image.");
-            return nullptr;
-        }
-        return image;
-    }
-
     class V8Image {
     public:
-        static void install(const v8::Local<v8::Object>& parent, Environment* env);
+
+        /**
+         * Returns nullptr if the image has been disposed.
+         */
+        static Image* toImpl(v8::Local<v8::Object> object) {
+            auto scriptWrappable = ToScriptWrappable(object);
+            return scriptWrappable ? scriptWrappable->toImpl<Image>() : nullptr;
+        }
+
+        static Image* toImplWithTypeCheck(v8::Isolate* isolate, v8::Local<v8::Value> value);
+        static const WrapperTypeInfo wrapperTypeInfo;
+
+        static void constructorCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+
+        static void widthAttributeGetterCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void heightAttributeGetterCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void transparentAttributeGetterCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+
+        static void disposeMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void encodeMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void encodeAsyncMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void getImageDataMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void makeSubsetMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void toDataURLMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void encodeAllMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
     };
 
 }
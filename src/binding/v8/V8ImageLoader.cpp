@@ -26,88 +26,471 @@
 
 
 #include "V8ImageLoader.h"
-#include <fstream>
+#include "V8Image.h"
+#include <algorithm>
+#include <memory>
 #include "base/Globals.h"
+#include "base/ThreadPool.h"
+#include "platform/FileData.h"
 #include "utils/Base64.h"
+#include "utils/Base64DecodeStream.h"
 #include "modules/image/Image.h"
+#include "modules/image/ImageCache.h"
+#include "modules/image/ImageDecoder.h"
 
 namespace cyder {
 
-    static void loadImageFromURLMethod(const v8::FunctionCallbackInfo<v8::Value>& args) {
-        auto env = Environment::GetCurrent(args);
-        v8::HandleScope scope(env->isolate());
-        auto url = env->toStdString(args[0]);
-        auto callback = v8::Local<v8::Function>::Cast(args[1]);
-        auto thisArg = v8::Local<v8::Object>::Cast(args[2]);
+    namespace {
+        /**
+         * The encoded bytes of an image and their cache key. The file of an image is only mapped if it is not cached.
+         */
+        struct ImageSource {
+            /**
+             * The cache key of the content, set once the file has been mapped for a file.
+             */
+            std::string key;
+            /**
+             * The cache alias of a file, which refers to the entry of its content without mapping the file.
+             */
+            std::string alias;
+            std::string path;
+            sk_sp<SkData> data;
+            /**
+             * The base64 text of a data URL, decoded while the codec reads it.
+             */
+            std::string base64;
+        };
 
-        char* buffer = nullptr;
-        size_t length = 0;
+        /**
+         * An image load in progress. It is created on the main thread, filled in on a thread of the pool, and then
+         * completed back on the main thread.
+         */
+        struct LoadRequest {
+            Environment* env;
+            v8::UniquePersistent<v8::Function> callback;
+            v8::UniquePersistent<v8::Object> thisArg;
+            std::string url;
+            ImageSource source;
+            ImageDecodeOptions options;
+            Image* image = nullptr;
+            /**
+             * The number of rows decoded per slice for a progressive load, 0 if the load is not progressive.
+             */
+            int progressiveRows = 0;
+            std::unique_ptr<ImageDecoder> decoder;
+            v8::UniquePersistent<v8::Object> imageObject;
+        };
+    }
+
+    /**
+     * Resolves the url to the source of the image, the base64 text of a data URL is kept and decoded later. Returns
+     * false if the url is not a valid data URL or does not refer to a file.
+     */
+    static bool ResolveURL(const std::string& url, const ImageDecodeOptions& options, ImageSource* source) {
         if (url.substr(0, 5) == "data:") {
             auto pos = url.find(",");
-            if (pos != std::string::npos && pos != 5) {
-                const char* data = url.c_str() + pos + 1;
-                size_t textLength = static_cast<size_t>(url.size() - pos - 1);
-                length = Base64::DecodeLength(textLength);
-                if (length > 0) {
-                    buffer = new char[length];
-                    Base64::Decode(data, textLength, buffer);
-                }
+            if (pos == std::string::npos || pos == 5) {
+                return false;
+            }
+            const char* text = url.c_str() + pos + 1;
+            size_t textLength = static_cast<size_t>(url.size() - pos - 1);
+            if (!Base64::DecodeLength(text, textLength)) {
+                return false;
             }
+            // The text is hashed instead of the bytes it encodes, there is no need to decode it for a cached image.
+            source->key = ImageCache::DataKey(text, textLength, options);
+            source->base64.assign(text, textLength);
+            return true;
         }
-        if (!buffer) {
-            url = Globals::resolvePath(url);
-            std::ifstream t;
-            t.open(url);
-            t.seekg(0, std::ios::end);
-            auto fileSize = t.tellg();
-            if (fileSize > 0) {
-                length = static_cast<size_t>(fileSize);
-                t.seekg(0, std::ios::beg);
-                buffer = new char[length];
-                t.read(buffer, length);
+        source->path = Globals::resolvePath(url);
+        int64_t modifiedTime = 0;
+        size_t size = 0;
+        if (!FileData::GetFileInfo(source->path, &modifiedTime, &size)) {
+            return false;
+        }
+        source->alias = ImageCache::FileKey(source->path, modifiedTime, size, options);
+        return true;
+    }
+
+    /**
+     * Returns the encoded bytes of the source.
+     */
+    static sk_sp<SkData> ReadSource(ImageSource* source) {
+        if (source->data) {
+            return source->data;
+        }
+        if (!source->base64.empty()) {
+            auto& text = source->base64;
+            auto data = SkData::MakeUninitialized(Base64::DecodeLength(text.data(), text.size()));
+            if (!Base64::Decode(text.data(), text.size(), static_cast<char*>(data->writable_data()))) {
+                return nullptr;
             }
-            t.close();
+            source->data = std::move(data);
+        } else {
+            // Map the file instead of reading it, the codec then reads the page cache directly.
+            source->data = FileData::MapFile(source->path);
         }
+        return source->data;
+    }
 
-        if (!buffer) {
-            env->call(callback, thisArg, env->makeNull());
+    /**
+     * Returns the memory held by a cached image, its decoded pixels or its encoded data for a lazy image.
+     */
+    static size_t CachedBytes(const SkImage* image, size_t encodedSize) {
+        return image->isLazyGenerated() ? encodedSize : static_cast<size_t>(image->width()) * image->height() * 4;
+    }
+
+    /**
+     * The size of the image cache last reported to v8, only accessed on the main thread.
+     */
+    static int64_t reportedCacheBytes = 0;
+
+    /**
+     * Reports the change of the image cache size to v8. The cache accounts for the pixels shared by all the images
+     * loaded from it, so they are only counted once. Runs on the main thread.
+     */
+    static void ReportImageCacheMemory(v8::Isolate* isolate) {
+        auto bytes = static_cast<int64_t>(ImageCache::GetInstance()->stats().bytes);
+        if (bytes == reportedCacheBytes) {
             return;
         }
+        isolate->AdjustAmountOfExternalAllocatedMemory(bytes - reportedCacheBytes);
+        reportedCacheBytes = bytes;
+    }
+
+    /**
+     * Creates an image sharing the pixels of the image cache.
+     */
+    static Image* MakeCachedImage(sk_sp<SkImage> pixels) {
+        auto image = new Image(pixels.release());
+        image->setPixelsCached(true);
+        return image;
+    }
+
+    /**
+     * Returns the image cached for the content of the source, or nullptr if there is not one. A file is first looked up
+     * by its alias, and only mapped and hashed if the alias is not known yet.
+     */
+    static Image* FindCachedImage(ImageSource* source, const ImageDecodeOptions& options) {
+        auto cache = ImageCache::GetInstance();
+        if (!source->alias.empty()) {
+            auto image = cache->findAlias(source->alias);
+            if (image) {
+                return MakeCachedImage(std::move(image));
+            }
+            auto data = ReadSource(source);
+            if (!data) {
+                return nullptr;
+            }
+            source->key = ImageCache::DataKey(data->data(), data->size(), options);
+        }
+        auto image = cache->find(source->key);
+        if (!image) {
+            return nullptr;
+        }
+        if (!source->alias.empty()) {
+            cache->addAlias(source->alias, source->key);
+        }
+        return MakeCachedImage(std::move(image));
+    }
 
-        auto image = Image::Decode(buffer, length);
-        delete[] buffer;
+    /**
+     * Adds the decoded image of the source to the image cache, along with the alias of its file. If the cache already
+     * has an image of the same content, that image is returned in place of the given one. Returns false if the image
+     * has not been cached.
+     */
+    static bool CacheImage(ImageSource* source, sk_sp<SkImage>& image, size_t bytes) {
+        if (source->key.empty()) {
+            return false;
+        }
+        auto cache = ImageCache::GetInstance();
+        bool cached = false;
+        image = cache->add(source->key, std::move(image), bytes, &cached);
+        if (cached && !source->alias.empty()) {
+            cache->addAlias(source->alias, source->key);
+        }
+        return cached;
+    }
+
+    /**
+     * Decodes the image of the source and adds the result to the image cache.
+     */
+    static Image* DecodeAndCache(ImageSource* source, const ImageDecodeOptions& options) {
+        sk_sp<SkImage> image;
+        size_t encodedSize = 0;
+        if (!source->base64.empty() && !options.lazy) {
+            // Decode the base64 text while the codec reads it, the decoded bytes are never stored as a whole.
+            auto stream = Base64DecodeStream::Make(std::move(source->base64));
+            if (!stream) {
+                return nullptr;
+            }
+            image = Image::DecodeImage(stream, options);
+        } else {
+            auto data = ReadSource(source);
+            if (!data) {
+                return nullptr;
+            }
+            encodedSize = data->size();
+            image = Image::DecodeImage(std::move(data), options);
+        }
         if (!image) {
-            env->call(callback, thisArg, env->makeNull());
+            return nullptr;
+        }
+        // A lazy image only holds its encoded data, the decoded pixels are accounted in the decoded image budget.
+        auto bytes = CachedBytes(image.get(), encodedSize);
+        if (CacheImage(source, image, bytes)) {
+            return MakeCachedImage(std::move(image));
+        }
+        return new Image(image.release());
+    }
+
+    /**
+     * Reads and decodes the image of the source, or returns the cached image of the same content, runs on a thread of
+     * the pool.
+     */
+    static Image* LoadImage(ImageSource* source, const ImageDecodeOptions& options) {
+        auto image = FindCachedImage(source, options);
+        if (image) {
+            return image;
+        }
+        return DecodeAndCache(source, options);
+    }
+
+    /**
+     * Passes the loaded image to the callback of the request, runs on the main thread.
+     */
+    static void CompleteLoad(LoadRequest* request) {
+        auto env = request->env;
+        auto isolate = env->isolate();
+        v8::HandleScope scope(isolate);
+        v8::Context::Scope contextScope(env->context());
+        v8::TryCatch tryCatch(isolate);
+        auto callback = v8::Local<v8::Function>::New(isolate, request->callback);
+        auto thisArg = v8::Local<v8::Object>::New(isolate, request->thisArg);
+        // The request may be destroyed on a thread of the pool, release the handles here.
+        request->callback.Reset();
+        request->thisArg.Reset();
+        v8::Local<v8::Value> result = env->makeNull();
+        if (request->image) {
+            result = ToV8(isolate, env->global(), request->image);
+        }
+        ReportImageCacheMemory(isolate);
+        if (env->call(callback, thisArg, result, env->makeValue(true)).IsEmpty()) {
+            // An error thrown by the callback, e.g. a failed load without any listener, must not end the process.
+            env->printStackTrace(tryCatch);
+        }
+    }
+
+    /**
+     * Starts decoding the image of the source progressively, or returns the cached image of the same content, runs on
+     * a thread of the pool.
+     */
+    static void StartProgressiveLoad(LoadRequest* request) {
+        request->image = FindCachedImage(&request->source, request->options);
+        if (request->image) {
+            return;
+        }
+        request->decoder.reset(ImageDecoder::Make(ReadSource(&request->source)));
+        request->source.data.reset();
+        if (request->decoder) {
+            request->decoder->decodeRows(request->progressiveRows);
+        }
+    }
+
+    /**
+     * Releases the handles and the decoder of a progressive load, runs on the main thread.
+     */
+    static void FinishProgressiveLoad(LoadRequest* request) {
+        request->callback.Reset();
+        request->thisArg.Reset();
+        request->imageObject.Reset();
+        request->decoder.reset();
+    }
+
+    static void ContinueLoad(const std::shared_ptr<LoadRequest>& request);
+
+    /**
+     * Shows the rows decoded by the last slice of a progressive load and passes the image to the callback, then
+     * starts the next slice unless the image is complete or the callback returns false. Runs on the main thread.
+     */
+    static void CommitProgressiveLoad(const std::shared_ptr<LoadRequest>& request) {
+        auto env = request->env;
+        auto isolate = env->isolate();
+        v8::HandleScope scope(isolate);
+        v8::Context::Scope contextScope(env->context());
+        v8::TryCatch tryCatch(isolate);
+        auto decoder = request->decoder.get();
+        v8::Local<v8::Object> imageObject;
+        Image* image;
+        sk_sp<SkImage> pixels;
+        if (request->imageObject.IsEmpty()) {
+            pixels = decoder->commitRows(false);
+            image = new Image(SkRef(pixels.get()));
+            imageObject = ToV8(isolate, env->global(), image).As<v8::Object>();
+            request->imageObject.Reset(isolate, imageObject);
+        } else {
+            imageObject = v8::Local<v8::Object>::New(isolate, request->imageObject);
+            image = V8Image::toImpl(imageObject);
+            if (!image) {
+                // The image has been disposed, there is no need to decode the rest of it.
+                FinishProgressiveLoad(request.get());
+                return;
+            }
+            // The rows are written into the pixels shown so far, unless something else reads them in the meantime.
+            pixels = decoder->commitRows(image->sharesPixels());
+            image->setPixels(pixels);
+            image->updateExternalMemory(isolate);
+        }
+        bool complete = decoder->finished();
+        if (complete && !decoder->failed()) {
+            auto bytes = static_cast<size_t>(decoder->width()) * decoder->height() * 4;
+            if (CacheImage(&request->source, pixels, bytes)) {
+                // Another load of the same content may have been cached first, share its pixels instead.
+                image->setPixels(std::move(pixels));
+                image->setPixelsCached(true);
+                image->updateExternalMemory(isolate);
+                ReportImageCacheMemory(isolate);
+            }
+        }
+        auto callback = v8::Local<v8::Function>::New(isolate, request->callback);
+        auto thisArg = v8::Local<v8::Object>::New(isolate, request->thisArg);
+        auto result = env->call(callback, thisArg, imageObject, env->makeValue(complete));
+        if (result.IsEmpty()) {
+            // Stop decoding the rest of the image, but keep the process running.
+            env->printStackTrace(tryCatch);
+            FinishProgressiveLoad(request.get());
             return;
         }
-        auto ImageClass = env->readGlobalFunction("Image");
-        auto imageObject = env->newInstance(ImageClass, env->makeExternal(image)).ToLocalChecked();
-        env->call(callback, thisArg, imageObject);
+        if (complete || result.ToLocalChecked()->IsFalse()) {
+            FinishProgressiveLoad(request.get());
+            return;
+        }
+        ThreadPool::Default()->post([request]() {
+            request->decoder->decodeRows(request->progressiveRows);
+        }, [request]() {
+            ContinueLoad(request);
+        });
+    }
+
+    /**
+     * Runs on the main thread once a slice of the load has been done on the thread pool.
+     */
+    static void ContinueLoad(const std::shared_ptr<LoadRequest>& request) {
+        if (request->decoder) {
+            CommitProgressiveLoad(request);
+        } else {
+            CompleteLoad(request.get());
+        }
+    }
+
+    static std::shared_ptr<LoadRequest> MakeLoadRequest(const v8::FunctionCallbackInfo<v8::Value>& args) {
+        auto env = Environment::GetCurrent(args);
+        auto request = std::make_shared<LoadRequest>();
+        request->env = env;
+        request->callback.Reset(env->isolate(), v8::Local<v8::Function>::Cast(args[1]));
+        request->thisArg.Reset(env->isolate(), v8::Local<v8::Object>::Cast(args[2]));
+        request->options.lazy = env->toBoolean(args[3]);
+        request->options.maxWidth = std::max(env->toInt(args[4]), 0);
+        request->options.maxHeight = std::max(env->toInt(args[5]), 0);
+        // A lazy or downsampled image is decoded quickly enough, they are never decoded progressively.
+        if (!request->options.lazy && !request->options.maxWidth && !request->options.maxHeight) {
+            request->progressiveRows = std::max(env->toInt(args[6]), 0);
+        }
+        return request;
+    }
+
+    static void loadImageFromURLMethod(const v8::FunctionCallbackInfo<v8::Value>& args) {
+        auto env = Environment::GetCurrent(args);
+        v8::HandleScope scope(env->isolate());
+        auto request = MakeLoadRequest(args);
+        request->url = env->toStdString(args[0]);
+        // Reading and decoding run on the thread pool, the callback is invoked asynchronously on the main thread.
+        ThreadPool::Default()->post([request]() {
+            if (!ResolveURL(request->url, request->options, &request->source)) {
+                return;
+            }
+            if (request->progressiveRows > 0) {
+                StartProgressiveLoad(request.get());
+            } else {
+                request->image = LoadImage(&request->source, request->options);
+            }
+        }, [request]() {
+            ContinueLoad(request);
+        });
     }
 
     static void loadImageFromBytesMethod(const v8::FunctionCallbackInfo<v8::Value>& args) {
         auto env = Environment::GetCurrent(args);
         v8::HandleScope scope(env->isolate());
         auto arrayBuffer = v8::Local<v8::ArrayBuffer>::Cast(args[0]);
-        auto buffer = arrayBuffer->GetContents().Data();
-        auto length = arrayBuffer->ByteLength();
-        auto callback = v8::Local<v8::Function>::Cast(args[1]);
-        auto thisArg = v8::Local<v8::Object>::Cast(args[2]);
-        auto image = Image::Decode(buffer, length);
-        if (!image) {
-            env->call(callback, thisArg, env->makeNull());
+        auto request = MakeLoadRequest(args);
+        // Scripts may modify the ArrayBuffer while it is decoded, decode a copy of it.
+        request->source.data = SkData::MakeWithCopy(arrayBuffer->GetContents().Data(), arrayBuffer->ByteLength());
+        ThreadPool::Default()->post([request]() {
+            auto& source = request->source;
+            if (!source.data->size()) {
+                return;
+            }
+            source.key = ImageCache::DataKey(source.data->data(), source.data->size(), request->options);
+            if (request->progressiveRows > 0) {
+                StartProgressiveLoad(request.get());
+            } else {
+                request->image = LoadImage(&source, request->options);
+            }
+        }, [request]() {
+            ContinueLoad(request);
+        });
+    }
+
+    static void getDecodedImageBudgetMethod(const v8::FunctionCallbackInfo<v8::Value>& args) {
+        args.GetReturnValue().Set(static_cast<double>(Image::DecodedImageBudget()));
+    }
+
+    static void setDecodedImageBudgetMethod(const v8::FunctionCallbackInfo<v8::Value>& args) {
+        auto env = Environment::GetCurrent(args);
+        auto bytes = env->toDouble(args[0]);
+        if (!(bytes >= 0)) {
+            env->throwError(ErrorType::RANGE_ERROR, "The decoded image budget must be a non-negative number.");
             return;
         }
-        auto ImageClass = env->readGlobalFunction("Image");
-        auto imageObject = env->newInstance(ImageClass, env->makeExternal(image)).ToLocalChecked();
-        env->call(callback, thisArg, imageObject);
+        Image::SetDecodedImageBudget(static_cast<size_t>(bytes));
+    }
+
+    static void getImageCacheBudgetMethod(const v8::FunctionCallbackInfo<v8::Value>& args) {
+        args.GetReturnValue().Set(static_cast<double>(ImageCache::GetInstance()->budget()));
     }
 
+    static void setImageCacheBudgetMethod(const v8::FunctionCallbackInfo<v8::Value>& args) {
+        auto env = Environment::GetCurrent(args);
+        auto bytes = env->toDouble(args[0]);
+        if (!(bytes >= 0)) {
+            env->throwError(ErrorType::RANGE_ERROR, "The image cache budget must be a non-negative number.");
+            return;
+        }
+        ImageCache::GetInstance()->setBudget(static_cast<size_t>(bytes));
+        ReportImageCacheMemory(env->isolate());
+    }
+
+    static void getImageCacheStatsMethod(const v8::FunctionCallbackInfo<v8::Value>& args) {
+        auto env = Environment::GetCurrent(args);
+        auto stats = ImageCache::GetInstance()->stats();
+        auto result = env->makeObject();
+        env->setObjectProperty(result, "hits", static_cast<double>(stats.hits), true);
+        env->setObjectProperty(result, "misses", static_cast<double>(stats.misses), true);
+        env->setObjectProperty(result, "count", static_cast<double>(stats.count), true);
+        env->setObjectProperty(result, "bytes", static_cast<double>(stats.bytes), true);
+        args.GetReturnValue().Set(result);
+    }
 
     void V8ImageLoader::install(const v8::Local<v8::Object>& parent, Environment* env) {
         auto cyderScope = env->readGlobalObject("cyder");
         env->setObjectProperty(cyderScope, "loadImageFromURL", loadImageFromURLMethod);
         env->setObjectProperty(cyderScope, "loadImageFromBytes", loadImageFromBytesMethod);
+        env->setObjectProperty(cyderScope, "getDecodedImageBudget", getDecodedImageBudgetMethod);
+        env->setObjectProperty(cyderScope, "setDecodedImageBudget", setDecodedImageBudgetMethod);
+        env->setObjectProperty(cyderScope, "getImageCacheBudget", getImageCacheBudgetMethod);
+        env->setObjectProperty(cyderScope, "setImageCacheBudget", setImageCacheBudgetMethod);
+        env->setObjectProperty(cyderScope, "getImageCacheStats", getImageCacheStatsMethod);
     }
 
 }
\ No newline at end of file
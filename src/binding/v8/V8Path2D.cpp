@@ -0,0 +1,206 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017-present, cyder.org
+//  All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in the
+//  Software without restriction, including without limitation the rights to use, copy,
+//  modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//  and to permit persons to whom the Software is furnished to do so, subject to the
+//  following conditions:
+//
+//      The above copyright notice and this permission notice shall be included in all
+//      copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED *AS IS*, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//  PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "V8Path2D.h"
+
+namespace cyder {
+
+    void V8Path2D::constructorCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto isolate = info.GetIsolate();
+        Path2D* impl;
+        if (info.Length() > 0 && !info[0]->IsUndefined()) {
+            auto path = V8Path2D::toImplWithTypeCheck(isolate, info[0]);
+            if (!path) {
+                ExceptionState exceptionState(isolate, ExceptionState::ConstructionContext, "Path2D");
+                exceptionState.throwTypeError(ExceptionMessages::ArgumentNullOrIncorrectType(1, "Path2D"));
+                return;
+            }
+            impl = new Path2D(path->path());
+        } else {
+            impl = new Path2D();
+        }
+        auto wrapper = info.Holder();
+        impl->setWrapper(isolate, wrapper);
+        SetReturnValue(info, wrapper);
+    }
+
+    void V8Path2D::addPathMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        ExceptionState exceptionState(info.GetIsolate(), ExceptionState::ExecutionContext, "Path2D", "addPath");
+        auto impl = V8Path2D::toImpl(info.Holder());
+        if (info.Length() < 1) {
+            exceptionState.throwTypeError(ExceptionMessages::NotEnoughArguments(1, info.Length()));
+            return;
+        }
+        auto path = V8Path2D::toImplWithTypeCheck(info.GetIsolate(), info[0]);
+        if (!path) {
+            exceptionState.throwTypeError(ExceptionMessages::ArgumentNullOrIncorrectType(1, "Path2D"));
+            return;
+        }
+        impl->addPath(path);
+    }
+
+    void V8Path2D::closePathMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        auto impl = V8Path2D::toImpl(info.Holder());
+        impl->closePath();
+    }
+
+    void V8Path2D::moveToMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        ExceptionState exceptionState(info.GetIsolate(), ExceptionState::ExecutionContext, "Path2D", "moveTo");
+        auto impl = V8Path2D::toImpl(info.Holder());
+        if (info.Length() < 2) {
+            exceptionState.throwTypeError(ExceptionMessages::NotEnoughArguments(2, info.Length()));
+            return;
+        }
+        auto isolate = info.GetIsolate();
+        auto x = ToFloat(isolate, info[0], exceptionState);
+        auto y = ToFloat(isolate, info[1], exceptionState);
+        if (exceptionState.hadException()) {
+            return;
+        }
+        impl->moveTo(x, y);
+    }
+
+    void V8Path2D::lineToMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        ExceptionState exceptionState(info.GetIsolate(), ExceptionState::ExecutionContext, "Path2D", "lineTo");
+        auto impl = V8Path2D::toImpl(info.Holder());
+        if (info.Length() < 2) {
+            exceptionState.throwTypeError(ExceptionMessages::NotEnoughArguments(2, info.Length()));
+            return;
+        }
+        auto isolate = info.GetIsolate();
+        auto x = ToFloat(isolate, info[0], exceptionState);
+        auto y = ToFloat(isolate, info[1], exceptionState);
+        if (exceptionState.hadException()) {
+            return;
+        }
+        impl->lineTo(x, y);
+    }
+
+    void V8Path2D::quadraticCurveToMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        ExceptionState exceptionState(info.GetIsolate(), ExceptionState::ExecutionContext,
+                                      "Path2D", "quadraticCurveTo");
+        auto impl = V8Path2D::toImpl(info.Holder());
+        if (info.Length() < 4) {
+            exceptionState.throwTypeError(ExceptionMessages::NotEnoughArguments(4, info.Length()));
+            return;
+        }
+        auto isolate = info.GetIsolate();
+        auto cpx = ToFloat(isolate, info[0], exceptionState);
+        auto cpy = ToFloat(isolate, info[1], exceptionState);
+        auto x = ToFloat(isolate, info[2], exceptionState);
+        auto y = ToFloat(isolate, info[3], exceptionState);
+        if (exceptionState.hadException()) {
+            return;
+        }
+        impl->quadraticCurveTo(cpx, cpy, x, y);
+    }
+
+    void V8Path2D::bezierCurveToMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        ExceptionState exceptionState(info.GetIsolate(), ExceptionState::ExecutionContext,
+                                      "Path2D", "bezierCurveTo");
+        auto impl = V8Path2D::toImpl(info.Holder());
+        if (info.Length() < 6) {
+            exceptionState.throwTypeError(ExceptionMessages::NotEnoughArguments(6, info.Length()));
+            return;
+        }
+        auto isolate = info.GetIsolate();
+        auto cp1x = ToFloat(isolate, info[0], exceptionState);
+        auto cp1y = ToFloat(isolate, info[1], exceptionState);
+        auto cp2x = ToFloat(isolate, info[2], exceptionState);
+        auto cp2y = ToFloat(isolate, info[3], exceptionState);
+        auto x = ToFloat(isolate, info[4], exceptionState);
+        auto y = ToFloat(isolate, info[5], exceptionState);
+        if (exceptionState.hadException()) {
+            return;
+        }
+        impl->bezierCurveTo(cp1x, cp1y, cp2x, cp2y, x, y);
+    }
+
+    void V8Path2D::arcMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        ExceptionState exceptionState(info.GetIsolate(), ExceptionState::ExecutionContext, "Path2D", "arc");
+        auto impl = V8Path2D::toImpl(info.Holder());
+        if (info.Length() < 5) {
+            exceptionState.throwTypeError(ExceptionMessages::NotEnoughArguments(5, info.Length()));
+            return;
+        }
+        auto isolate = info.GetIsolate();
+        auto x = ToFloat(isolate, info[0], exceptionState);
+        auto y = ToFloat(isolate, info[1], exceptionState);
+        auto radius = ToFloat(isolate, info[2], exceptionState);
+        auto startAngle = ToFloat(isolate, info[3], exceptionState);
+        auto endAngle = ToFloat(isolate, info[4], exceptionState);
+        auto anticlockwise = info.Length() > 5 && ToBoolean(isolate, info[5], exceptionState);
+        if (exceptionState.hadException()) {
+            return;
+        }
+        if (!impl->arc(x, y, radius, startAngle, endAngle, anticlockwise)) {
+            exceptionState.throwRangeError("The radius provided (" + std::to_string(radius) + ") is negative.");
+        }
+    }
+
+    void V8Path2D::rectMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+        ExceptionState exceptionState(info.GetIsolate(), ExceptionState::ExecutionContext, "Path2D", "rect");
+        auto impl = V8Path2D::toImpl(info.Holder());
+        if (info.Length() < 4) {
+            exceptionState.throwTypeError(ExceptionMessages::NotEnoughArguments(4, info.Length()));
+            return;
+        }
+        auto isolate = info.GetIsolate();
+        auto x = ToFloat(isolate, info[0], exceptionState);
+        auto y = ToFloat(isolate, info[1], exceptionState);
+        auto width = ToFloat(isolate, info[2], exceptionState);
+        auto height = ToFloat(isolate, info[3], exceptionState);
+        if (exceptionState.hadException()) {
+            return;
+        }
+        impl->rect(x, y, width, height);
+    }
+
+    Path2D* V8Path2D::toImplWithTypeCheck(v8::Isolate* isolate, v8::Local<v8::Value> value) {
+        return V8Binding::HasInstance(isolate, &wrapperTypeInfo, value) ?
+               toImpl(v8::Local<v8::Object>::Cast(value)) : nullptr;
+    }
+
+    static const MethodConfiguration V8Path2DMethods[] = {
+            {"addPath",          V8Path2D::addPathMethodCallback,          1, v8::None, InstallOnPrototype},
+            {"closePath",        V8Path2D::closePathMethodCallback,        0, v8::None, InstallOnPrototype},
+            {"moveTo",           V8Path2D::moveToMethodCallback,           2, v8::None, InstallOnPrototype},
+            {"lineTo",           V8Path2D::lineToMethodCallback,           2, v8::None, InstallOnPrototype},
+            {"quadraticCurveTo", V8Path2D::quadraticCurveToMethodCallback, 4, v8::None, InstallOnPrototype},
+            {"bezierCurveTo",    V8Path2D::bezierCurveToMethodCallback,    6, v8::None, InstallOnPrototype},
+            {"arc",              V8Path2D::arcMethodCallback,              5, v8::None, InstallOnPrototype},
+            {"rect",             V8Path2D::rectMethodCallback,             4, v8::None, InstallOnPrototype}
+    };
+
+    const WrapperTypeInfo V8Path2D::wrapperTypeInfo = {nullptr, "Path2D",
+                                                       V8Path2D::constructorCallback, 0,
+                                                       nullptr, 0,
+                                                       V8Path2DMethods, 8,
+                                                       nullptr, 0,
+                                                       nullptr, 0};
+
+    const WrapperTypeInfo& Path2D::wrapperTypeInfo = V8Path2D::wrapperTypeInfo;
+}
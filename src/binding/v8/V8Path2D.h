@@ -0,0 +1,59 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017-present, cyder.org
+//  All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in the
+//  Software without restriction, including without limitation the rights to use, copy,
+//  modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//  and to permit persons to whom the Software is furnished to do so, subject to the
+//  following conditions:
+//
+//      The above copyright notice and this permission notice shall be included in all
+//      copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED *AS IS*, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//  PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CYDER_V8PATH2D_H
+#define CYDER_V8PATH2D_H
+
+#include "binding/V8Binding.h"
+#include "modules/canvas2d/Path2D.h"
+
+namespace cyder {
+
+    class V8Path2D {
+    public:
+
+        static Path2D* toImpl(v8::Local<v8::Object> object) {
+            return ToScriptWrappable(object)->toImpl<Path2D>();
+        }
+
+        static Path2D* toImplWithTypeCheck(v8::Isolate* isolate, v8::Local<v8::Value> value);
+        static const WrapperTypeInfo wrapperTypeInfo;
+
+        static void constructorCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+
+        static void addPathMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void closePathMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void moveToMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void lineToMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void quadraticCurveToMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void bezierCurveToMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void arcMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void rectMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& info);
+    };
+
+}
+
+#endif //CYDER_V8PATH2D_H
@@ -27,6 +27,7 @@
 
 #include "V8Performance.h"
 #include "utils/GetTimer.h"
+#include "binding/ArrayBufferAllocator.h"
 
 namespace cyder {
 
@@ -34,9 +35,24 @@ namespace cyder {
         args.GetReturnValue().Set(GetTimer());
     }
 
+    static void getArrayBufferStatsMethod(const v8::FunctionCallbackInfo<v8::Value>& args) {
+        auto env = Environment::GetCurrent(args);
+        auto stats = ArrayBufferAllocator::GetInstance()->stats();
+        auto result = env->makeObject();
+        env->setObjectProperty(result, "liveBytes", static_cast<double>(stats.liveBytes), true);
+        env->setObjectProperty(result, "peakBytes", static_cast<double>(stats.peakBytes), true);
+        env->setObjectProperty(result, "liveCount", static_cast<double>(stats.liveCount), true);
+        env->setObjectProperty(result, "allocationCount", static_cast<double>(stats.allocationCount), true);
+        env->setObjectProperty(result, "reuseCount", static_cast<double>(stats.reuseCount), true);
+        env->setObjectProperty(result, "pooledBytes", static_cast<double>(stats.pooledBytes), true);
+        env->setObjectProperty(result, "slabBytes", static_cast<double>(stats.slabBytes), true);
+        args.GetReturnValue().Set(result);
+    }
+
     void V8Performance::install(const v8::Local<v8::Object>& parent, Environment* env) {
         auto performance = env->makeObject();
         env->setObjectProperty(performance, "now", nowMethod);
+        env->setObjectProperty(performance, "getArrayBufferStats", getArrayBufferStatsMethod);
         env->setObjectProperty(parent, "performance", performance);
     }
 
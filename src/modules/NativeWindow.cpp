@@ -26,6 +26,8 @@
 
 #include <platform/SurfaceFactory.h>
 #include "NativeWindow.h"
+#include "binding/ToV8.h"
+#include "modules/canvas/Canvas.h"
 
 namespace cyder {
 
@@ -39,20 +41,19 @@ namespace cyder {
         weakHandle.SetWeak();
         weakHandle.MarkIndependent();
         WindowInitOptions options;
+        options.width = 800;
+        options.height = 600;
         window = Window::New(options);
         window->setX(300);
         window->setY(150);
-        window->setContentSize(800, 600);
         window->setTitle("CYDER");
         window->setDelegate(this);
 
         auto self = args.This();
         auto eventEmitterClass = env->readGlobalFunction("cyder.EventEmitter");
         env->call(eventEmitterClass, self); // call the super class function.
-        auto CanvasClass = env->readGlobalFunction("Canvas");
-        auto canvas = env->newInstance(CanvasClass,
-                                       env->makeExternal(window->screenBuffer())).ToLocalChecked();
-        env->setObjectProperty(self, "canvas", canvas, true);
+        auto canvas = new Canvas(window->screenBuffer());
+        env->setObjectProperty(self, "canvas", ToV8(env->isolate(), self, canvas), true);
 
         onResized();
     }
@@ -27,14 +27,24 @@
 #ifndef CYDER_CANVAS_H
 #define CYDER_CANVAS_H
 
+#include <string>
+#include "binding/ScriptWrappable.h"
+#include "modules/canvas/DrawingBuffer.h"
+#include "modules/canvas/RenderingContext.h"
+
 namespace cyder {
 
-    class Canvas {
+    class Canvas : public ScriptWrappable {
+    DEFINE_WRAPPERTYPEINFO();
+
     public:
         std::string contextType = "";
         DrawingBuffer* buffer = nullptr;
+        /**
+         * The rendering context of the canvas, it is owned by its wrapper. The wrappers of the canvas and of its
+         * context keep each other alive, so they are always collected together.
+         */
         RenderingContext* context = nullptr;
-        v8::Persistent<v8::Object> contextObject;
 
         Canvas(int width = 200, int height = 200) : _width(width), _height(height) {
         }
@@ -43,13 +53,15 @@ namespace cyder {
         }
 
         ~Canvas() {
-            contextObject.Reset();
-            delete context;
             if (!externalBuffer) {
                 delete buffer;
             }
         }
 
+        size_t memoryUsage() const override {
+            return buffer && !externalBuffer ? buffer->memoryUsage() : 0;
+        }
+
         int width() const {
             return buffer ? buffer->width() : _width;
         }
@@ -35,7 +35,15 @@ namespace cyder {
     public:
         virtual ~CanvasImageSource() {}
 
-        virtual void draw(SkCanvas* canvas, const SkRect& dstRect, const SkRect& srcRect) = 0;
+        virtual void draw(SkCanvas* canvas, const SkRect& dstRect, const SkRect& srcRect, const SkPaint* paint) = 0;
+
+        /**
+         * Draws a batch of sprites of this image in one call. Each sprite is defined by a rotation-scale transform, a
+         * sub-rectangle of the image and an optional color which is modulated with the sprite. The source rects are
+         * scratch storage of the caller, they may be modified, e.g. moved into the coordinate space of shared pixels.
+         */
+        virtual void drawAtlas(SkCanvas* canvas, const SkRSXform transforms[], SkRect srcRects[],
+                               const SkColor colors[], int count, const SkPaint* paint) = 0;
 
         virtual int width() const = 0;
 
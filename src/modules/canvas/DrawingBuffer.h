@@ -51,12 +51,29 @@ namespace cyder {
 
         virtual void setHeight(int value) = 0;
 
+        /**
+         * Returns the number of bytes of pixel memory owned by the buffer, zero if the memory is not owned by it.
+         */
+        virtual size_t memoryUsage() const {
+            return 0;
+        }
+
         /**
          * Return a canvas that will draw into this drawing buffer.
          * Note: Do not cache the return value of surface(), it may change when DrawingBuffer resizes.
          */
         virtual SkCanvas* getCanvas() = 0;
 
+        /**
+         * Returns a canvas that will draw into this drawing buffer, like getCanvas(), and tells the buffer that the
+         * drawing only changes the pixels in the specified rectangle. Buffers presented to the screen use it to only
+         * present the areas that changed.
+         * @param dirtyRect The rectangle that the drawing changes, in pixels.
+         */
+        virtual SkCanvas* getCanvasForRect(const SkIRect& dirtyRect) {
+            return getCanvas();
+        }
+
         /**
          * Draws this buffer directly into another canvas.
          */
@@ -67,6 +84,30 @@ namespace cyder {
          * will not be reflected in this image.
          */
         virtual Image* makeImageSnapshot() = 0;
+
+        /**
+         * Gives direct access to the pixels of the buffer if they are stored in CPU memory, e.g. the buffer is
+         * rasterized by the CPU. Any pending drawing is applied to the pixels first.
+         * @param pixmap Receives the address and the format of the pixels. It is valid until the next call to a method
+         * of the buffer.
+         * @param writeRect The rectangle of pixels that the caller is going to modify, or nullptr if the pixels are
+         * only read. The snapshots taken from the buffer keep their content.
+         * @returns false if the pixels are not directly accessible, use readPixels() and writePixels() instead.
+         */
+        virtual bool peekPixels(SkPixmap* pixmap, const SkIRect* writeRect) = 0;
+
+        /**
+         * Copies a rectangle of pixels from the buffer to the specified pixels, converting them to the format of info.
+         * The part of the rectangle outside of the buffer is left untouched.
+         * @returns false if the pixels could not be read.
+         */
+        virtual bool readPixels(const SkImageInfo& info, void* pixels, size_t rowBytes, int x, int y) = 0;
+
+        /**
+         * Copies the specified pixels into a rectangle of the buffer, ignoring the clip and the transform.
+         * @returns false if the pixels could not be written.
+         */
+        virtual bool writePixels(const SkImageInfo& info, const void* pixels, size_t rowBytes, int x, int y) = 0;
     };
 
 }
@@ -26,10 +26,11 @@
 
 #include "OffScreenBuffer.h"
 #include "platform/SurfaceFactory.h"
+#include "modules/canvas/PictureHasher.h"
 
 namespace cyder {
-    OffScreenBuffer::OffScreenBuffer(int width, int height, bool alpha, bool useGPU) :
-            _width(width), _height(height), alpha(alpha), useGPU(useGPU) {
+    OffScreenBuffer::OffScreenBuffer(int width, int height, bool alpha, bool useGPU, bool recording) :
+            _width(width), _height(height), alpha(alpha), useGPU(useGPU), recording(recording) {
 
     }
 
@@ -37,11 +38,64 @@ namespace cyder {
         SkSafeUnref(surface);
     }
 
+    SkCanvas* OffScreenBuffer::getCanvas() {
+        if (!recording) {
+            return getSurface()->getCanvas();
+        }
+        auto canvas = recorder.getRecordingCanvas();
+        if (!canvas) {
+            canvas = recorder.beginRecording(SkRect::MakeIWH(_width, _height));
+        }
+        return canvas;
+    }
+
+    void OffScreenBuffer::finishRecording() {
+        if (!recorder.getRecordingCanvas()) {
+            return;
+        }
+        auto picture = recorder.finishRecordingAsPicture();
+        uint64_t hash = 0;
+        bool cacheable = PictureHasher::Hash(picture.get(), &hash);
+        auto surface = getSurface();
+        if (cacheable && hasFingerprint && hash == fingerprint) {
+            // Same commands as last time, the pixels in the surface are still up to date.
+            return;
+        }
+        auto canvas = surface->getCanvas();
+        canvas->clear(alpha ? SK_ColorTRANSPARENT : SK_ColorBLACK);
+        canvas->drawPicture(picture);
+        fingerprint = hash;
+        hasFingerprint = cacheable;
+    }
+
     Image* OffScreenBuffer::makeImageSnapshot() {
+        finishRecording();
         auto image = getSurface()->makeImageSnapshot().release();
         return new Image(image);
     }
 
+    bool OffScreenBuffer::peekPixels(SkPixmap* pixmap, const SkIRect* writeRect) {
+        finishRecording();
+        auto surface = getSurface();
+        if (writeRect) {
+            // Copies the pixels on write if a snapshot shares them. The pixels are not part of a recording anymore.
+            surface->notifyContentWillChange(SkSurface::kRetain_ContentChangeMode);
+            hasFingerprint = false;
+        }
+        return surface->peekPixels(pixmap);
+    }
+
+    bool OffScreenBuffer::readPixels(const SkImageInfo& info, void* pixels, size_t rowBytes, int x, int y) {
+        finishRecording();
+        return getSurface()->readPixels(info, pixels, rowBytes, x, y);
+    }
+
+    bool OffScreenBuffer::writePixels(const SkImageInfo& info, const void* pixels, size_t rowBytes, int x, int y) {
+        finishRecording();
+        hasFingerprint = false;
+        return getSurface()->getCanvas()->writePixels(info, pixels, rowBytes, x, y);
+    }
+
     SkSurface* OffScreenBuffer::getSurface() {
         if (surface) {
             return surface;
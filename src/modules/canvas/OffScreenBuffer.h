@@ -34,7 +34,17 @@ namespace cyder {
 
     class OffScreenBuffer : public DrawingBuffer {
     public:
-        OffScreenBuffer(int width, int height, bool alpha = true, bool useGPU = true);
+        /**
+         * Creates a new OffScreenBuffer.
+         * @param width The width of the buffer, in pixels.
+         * @param height The height of the buffer, in pixels.
+         * @param alpha Whether the buffer contains an alpha channel.
+         * @param useGPU Whether to rasterize with the GPU.
+         * @param recording Whether to record the drawing commands into a picture instead of rasterizing them right
+         * away. In recording mode, every recording replaces the whole content of the buffer, and the recording is
+         * rasterized only when the buffer is read (draw() or makeImageSnapshot()) and differs from the previous one.
+         */
+        OffScreenBuffer(int width, int height, bool alpha = true, bool useGPU = true, bool recording = false);
 
         ~OffScreenBuffer() override;
 
@@ -62,27 +72,56 @@ namespace cyder {
             _height = value;
         }
 
-        SkCanvas* getCanvas() override {
-            return getSurface()->getCanvas();
+        /**
+         * Returns the size of the surface of the buffer, in CPU or GPU memory. The surface is counted even before it
+         * is allocated, a recording buffer allocates it lazily when it is first read, e.g. in draw().
+         */
+        size_t memoryUsage() const override {
+            return static_cast<size_t>(_width) * _height * 4;
         }
 
+        SkCanvas* getCanvas() override;
+
         void draw(SkCanvas* canvas, SkScalar x, SkScalar y, const SkPaint* paint) override {
+            finishRecording();
             getSurface()->draw(canvas, x, y, paint);
         }
 
         Image* makeImageSnapshot() override;
 
+        bool peekPixels(SkPixmap* pixmap, const SkIRect* writeRect) override;
+
+        bool readPixels(const SkImageInfo& info, void* pixels, size_t rowBytes, int x, int y) override;
+
+        bool writePixels(const SkImageInfo& info, const void* pixels, size_t rowBytes, int x, int y) override;
+
     private:
         int _width;
         int _height;
         bool useGPU;
         bool alpha;
+        bool recording;
         bool contentChanged = false;
         SkSurface* surface = nullptr;
+        SkPictureRecorder recorder;
+        /**
+         * The fingerprint of the recording currently rasterized in the surface, valid if hasFingerprint is true.
+         */
+        uint64_t fingerprint = 0;
+        bool hasFingerprint = false;
 
         SkSurface* getSurface();
 
+        /**
+         * Ends the current recording, if any, and rasterizes it unless it is identical to the previous one.
+         */
+        void finishRecording();
+
         void invalidateSize() {
+            if (recorder.getRecordingCanvas()) {
+                recorder.finishRecordingAsPicture();
+            }
+            hasFingerprint = false;
             if (surface) {
                 SkSafeUnref(surface);
                 surface = nullptr;
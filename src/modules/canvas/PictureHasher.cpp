@@ -0,0 +1,449 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017-present, cyder.org
+//  All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in the
+//  Software without restriction, including without limitation the rights to use, copy,
+//  modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//  and to permit persons to whom the Software is furnished to do so, subject to the
+//  following conditions:
+//
+//      The above copyright notice and this permission notice shall be included in all
+//      copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED *AS IS*, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//  PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "PictureHasher.h"
+#include <cstring>
+#include <vector>
+
+namespace cyder {
+
+    namespace {
+        enum Op {
+            SAVE = 1, SAVE_LAYER, RESTORE, CONCAT, SET_MATRIX, TRANSLATE, CLIP_RECT, CLIP_RRECT, CLIP_PATH, CLIP_REGION,
+            DRAW_ANNOTATION, DRAW_PAINT, DRAW_POINTS, DRAW_RECT, DRAW_REGION, DRAW_OVAL, DRAW_ARC, DRAW_RRECT,
+            DRAW_DRRECT, DRAW_PATH, DRAW_TEXT, DRAW_POS_TEXT, DRAW_POS_TEXT_H, DRAW_TEXT_ON_PATH, DRAW_TEXT_RSXFORM,
+            DRAW_TEXT_BLOB, DRAW_IMAGE, DRAW_IMAGE_RECT, DRAW_IMAGE_NINE, DRAW_BITMAP, DRAW_BITMAP_RECT,
+            DRAW_BITMAP_NINE, DRAW_ATLAS, DRAW_VERTICES, DRAW_PATCH, DRAW_PICTURE
+        };
+    }
+
+    bool PictureHasher::Hash(const SkPicture* picture, uint64_t* result) {
+        auto bounds = picture->cullRect().roundOut();
+        PictureHasher hasher(bounds.width(), bounds.height());
+        picture->playback(&hasher);
+        *result = hasher.hash;
+        return hasher.cacheable;
+    }
+
+    void PictureHasher::add(const void* data, size_t length) {
+        // FNV-1a, fast enough for command streams and stable across runs.
+        auto bytes = static_cast<const uint8_t*>(data);
+        auto end = bytes + length;
+        while (bytes < end) {
+            hash ^= *bytes++;
+            hash *= 1099511628211ULL;
+        }
+    }
+
+    void PictureHasher::addPaint(const SkPaint* paint) {
+        if (!paint) {
+            add(false);
+            return;
+        }
+        add(true);
+        // Effects are only known by their addresses, which may be reused by a new effect once the previous picture is
+        // freed, so they can not be fingerprinted without serializing them.
+        if (paint->getShader() || paint->getColorFilter() || paint->getPathEffect() || paint->getMaskFilter() ||
+            paint->getImageFilter() || paint->getRasterizer() || paint->getDrawLooper()) {
+            cacheable = false;
+            return;
+        }
+        auto typeface = paint->getTypeface();
+        add(typeface ? typeface->uniqueID() : 0);
+        add(paint->getColor());
+        add(paint->getStrokeWidth());
+        add(paint->getStrokeMiter());
+        add(paint->getFlags());
+        add(paint->getBlendMode());
+        add(paint->getStyle());
+        add(paint->getStrokeCap());
+        add(paint->getStrokeJoin());
+        add(paint->getFilterQuality());
+        add(paint->getTextSize());
+        add(paint->getTextScaleX());
+        add(paint->getTextSkewX());
+        add(paint->getTextEncoding());
+        add(paint->getTextAlign());
+        add(paint->getHinting());
+    }
+
+    void PictureHasher::addMatrix(const SkMatrix* matrix) {
+        if (!matrix) {
+            add(false);
+            return;
+        }
+        SkScalar values[9];
+        matrix->get9(values);
+        add(true);
+        add(values);
+    }
+
+    void PictureHasher::addRRect(const SkRRect& rrect) {
+        char buffer[SkRRect::kSizeInMemory];
+        rrect.writeToMemory(buffer);
+        add(buffer);
+    }
+
+    void PictureHasher::addRegion(const SkRegion& region) {
+        std::vector<char> buffer(region.writeToMemory(nullptr));
+        region.writeToMemory(buffer.data());
+        add(buffer.data(), buffer.size());
+    }
+
+    void PictureHasher::addImage(const SkImage* image) {
+        add(image ? image->uniqueID() : 0);
+    }
+
+    void PictureHasher::addBitmap(const SkBitmap& bitmap) {
+        add(bitmap.getGenerationID());
+        add(bitmap.pixelRefOrigin());
+        add(bitmap.width());
+        add(bitmap.height());
+    }
+
+    void PictureHasher::addRect(const SkRect* rect) {
+        if (!rect) {
+            add(false);
+            return;
+        }
+        add(true);
+        add(*rect);
+    }
+
+    void PictureHasher::willSave() {
+        addOp(SAVE);
+    }
+
+    SkCanvas::SaveLayerStrategy PictureHasher::getSaveLayerStrategy(const SaveLayerRec& rec) {
+        addOp(SAVE_LAYER);
+        addRect(rec.fBounds);
+        addPaint(rec.fPaint);
+        add(rec.fSaveLayerFlags);
+        if (rec.fBackdrop) {
+            cacheable = false;
+        }
+        return kNoLayer_SaveLayerStrategy;
+    }
+
+    void PictureHasher::willRestore() {
+        addOp(RESTORE);
+    }
+
+    void PictureHasher::didConcat(const SkMatrix& matrix) {
+        addOp(CONCAT);
+        addMatrix(&matrix);
+    }
+
+    void PictureHasher::didSetMatrix(const SkMatrix& matrix) {
+        addOp(SET_MATRIX);
+        addMatrix(&matrix);
+    }
+
+    void PictureHasher::didTranslate(SkScalar dx, SkScalar dy) {
+        addOp(TRANSLATE);
+        add(dx);
+        add(dy);
+    }
+
+    void PictureHasher::onClipRect(const SkRect& rect, SkClipOp op, ClipEdgeStyle edgeStyle) {
+        addOp(CLIP_RECT);
+        add(rect);
+        add(op);
+        add(edgeStyle);
+        SkNoDrawCanvas::onClipRect(rect, op, edgeStyle);
+    }
+
+    void PictureHasher::onClipRRect(const SkRRect& rrect, SkClipOp op, ClipEdgeStyle edgeStyle) {
+        addOp(CLIP_RRECT);
+        addRRect(rrect);
+        add(op);
+        add(edgeStyle);
+        SkNoDrawCanvas::onClipRRect(rrect, op, edgeStyle);
+    }
+
+    void PictureHasher::onClipPath(const SkPath& path, SkClipOp op, ClipEdgeStyle edgeStyle) {
+        addOp(CLIP_PATH);
+        add(path.getGenerationID());
+        add(path.getFillType());
+        add(op);
+        add(edgeStyle);
+        SkNoDrawCanvas::onClipPath(path, op, edgeStyle);
+    }
+
+    void PictureHasher::onClipRegion(const SkRegion& region, SkClipOp op) {
+        addOp(CLIP_REGION);
+        addRegion(region);
+        add(op);
+        SkNoDrawCanvas::onClipRegion(region, op);
+    }
+
+    void PictureHasher::onDrawAnnotation(const SkRect& rect, const char key[], SkData* value) {
+        addOp(DRAW_ANNOTATION);
+        add(rect);
+        add(key, strlen(key));
+        if (value) {
+            add(value->data(), value->size());
+        }
+    }
+
+    void PictureHasher::onDrawPaint(const SkPaint& paint) {
+        addOp(DRAW_PAINT);
+        addPaint(&paint);
+    }
+
+    void PictureHasher::onDrawPoints(PointMode mode, size_t count, const SkPoint pts[], const SkPaint& paint) {
+        addOp(DRAW_POINTS);
+        add(mode);
+        add(pts, count * sizeof(SkPoint));
+        addPaint(&paint);
+    }
+
+    void PictureHasher::onDrawRect(const SkRect& rect, const SkPaint& paint) {
+        addOp(DRAW_RECT);
+        add(rect);
+        addPaint(&paint);
+    }
+
+    void PictureHasher::onDrawRegion(const SkRegion& region, const SkPaint& paint) {
+        addOp(DRAW_REGION);
+        addRegion(region);
+        addPaint(&paint);
+    }
+
+    void PictureHasher::onDrawOval(const SkRect& rect, const SkPaint& paint) {
+        addOp(DRAW_OVAL);
+        add(rect);
+        addPaint(&paint);
+    }
+
+    void PictureHasher::onDrawArc(const SkRect& rect, SkScalar startAngle, SkScalar sweepAngle, bool useCenter,
+                                  const SkPaint& paint) {
+        addOp(DRAW_ARC);
+        add(rect);
+        add(startAngle);
+        add(sweepAngle);
+        add(useCenter);
+        addPaint(&paint);
+    }
+
+    void PictureHasher::onDrawRRect(const SkRRect& rrect, const SkPaint& paint) {
+        addOp(DRAW_RRECT);
+        addRRect(rrect);
+        addPaint(&paint);
+    }
+
+    void PictureHasher::onDrawDRRect(const SkRRect& outer, const SkRRect& inner, const SkPaint& paint) {
+        addOp(DRAW_DRRECT);
+        addRRect(outer);
+        addRRect(inner);
+        addPaint(&paint);
+    }
+
+    void PictureHasher::onDrawPath(const SkPath& path, const SkPaint& paint) {
+        addOp(DRAW_PATH);
+        add(path.getGenerationID());
+        add(path.getFillType());
+        addPaint(&paint);
+    }
+
+    void PictureHasher::onDrawText(const void* text, size_t byteLength, SkScalar x, SkScalar y,
+                                   const SkPaint& paint) {
+        addOp(DRAW_TEXT);
+        add(text, byteLength);
+        add(x);
+        add(y);
+        addPaint(&paint);
+    }
+
+    void PictureHasher::onDrawPosText(const void* text, size_t byteLength, const SkPoint pos[],
+                                      const SkPaint& paint) {
+        addOp(DRAW_POS_TEXT);
+        add(text, byteLength);
+        add(pos, paint.countText(text, byteLength) * sizeof(SkPoint));
+        addPaint(&paint);
+    }
+
+    void PictureHasher::onDrawPosTextH(const void* text, size_t byteLength, const SkScalar xpos[], SkScalar constY,
+                                       const SkPaint& paint) {
+        addOp(DRAW_POS_TEXT_H);
+        add(text, byteLength);
+        add(xpos, paint.countText(text, byteLength) * sizeof(SkScalar));
+        add(constY);
+        addPaint(&paint);
+    }
+
+    void PictureHasher::onDrawTextOnPath(const void* text, size_t byteLength, const SkPath& path,
+                                         const SkMatrix* matrix, const SkPaint& paint) {
+        addOp(DRAW_TEXT_ON_PATH);
+        add(text, byteLength);
+        add(path.getGenerationID());
+        addMatrix(matrix);
+        addPaint(&paint);
+    }
+
+    void PictureHasher::onDrawTextRSXform(const void* text, size_t byteLength, const SkRSXform xform[],
+                                          const SkRect* cullRect, const SkPaint& paint) {
+        addOp(DRAW_TEXT_RSXFORM);
+        add(text, byteLength);
+        add(xform, paint.countText(text, byteLength) * sizeof(SkRSXform));
+        addRect(cullRect);
+        addPaint(&paint);
+    }
+
+    void PictureHasher::onDrawTextBlob(const SkTextBlob* blob, SkScalar x, SkScalar y, const SkPaint& paint) {
+        addOp(DRAW_TEXT_BLOB);
+        add(blob->uniqueID());
+        add(x);
+        add(y);
+        addPaint(&paint);
+    }
+
+    void PictureHasher::onDrawImage(const SkImage* image, SkScalar x, SkScalar y, const SkPaint* paint) {
+        addOp(DRAW_IMAGE);
+        addImage(image);
+        add(x);
+        add(y);
+        addPaint(paint);
+    }
+
+    void PictureHasher::onDrawImageRect(const SkImage* image, const SkRect* src, const SkRect& dst,
+                                        const SkPaint* paint, SrcRectConstraint constraint) {
+        addOp(DRAW_IMAGE_RECT);
+        addImage(image);
+        addRect(src);
+        add(dst);
+        addPaint(paint);
+        add(constraint);
+    }
+
+    void PictureHasher::onDrawImageNine(const SkImage* image, const SkIRect& center, const SkRect& dst,
+                                        const SkPaint* paint) {
+        addOp(DRAW_IMAGE_NINE);
+        addImage(image);
+        add(center);
+        add(dst);
+        addPaint(paint);
+    }
+
+    void PictureHasher::onDrawImageLattice(const SkImage* image, const Lattice& lattice, const SkRect& dst,
+                                           const SkPaint* paint) {
+        // Lattices are not produced by the canvas APIs we expose, keep it simple and never cache them.
+        cacheable = false;
+    }
+
+    void PictureHasher::onDrawBitmap(const SkBitmap& bitmap, SkScalar x, SkScalar y, const SkPaint* paint) {
+        addOp(DRAW_BITMAP);
+        addBitmap(bitmap);
+        add(x);
+        add(y);
+        addPaint(paint);
+    }
+
+    void PictureHasher::onDrawBitmapRect(const SkBitmap& bitmap, const SkRect* src, const SkRect& dst,
+                                         const SkPaint* paint, SrcRectConstraint constraint) {
+        addOp(DRAW_BITMAP_RECT);
+        addBitmap(bitmap);
+        addRect(src);
+        add(dst);
+        addPaint(paint);
+        add(constraint);
+    }
+
+    void PictureHasher::onDrawBitmapNine(const SkBitmap& bitmap, const SkIRect& center, const SkRect& dst,
+                                         const SkPaint* paint) {
+        addOp(DRAW_BITMAP_NINE);
+        addBitmap(bitmap);
+        add(center);
+        add(dst);
+        addPaint(paint);
+    }
+
+    void PictureHasher::onDrawBitmapLattice(const SkBitmap& bitmap, const Lattice& lattice, const SkRect& dst,
+                                            const SkPaint* paint) {
+        cacheable = false;
+    }
+
+    void PictureHasher::onDrawAtlas(const SkImage* atlas, const SkRSXform xform[], const SkRect tex[],
+                                    const SkColor colors[], int count, SkBlendMode mode, const SkRect* cullRect,
+                                    const SkPaint* paint) {
+        addOp(DRAW_ATLAS);
+        addImage(atlas);
+        add(xform, count * sizeof(SkRSXform));
+        add(tex, count * sizeof(SkRect));
+        if (colors) {
+            add(colors, count * sizeof(SkColor));
+        }
+        add(mode);
+        addRect(cullRect);
+        addPaint(paint);
+    }
+
+    void PictureHasher::onDrawVertices(VertexMode mode, int vertexCount, const SkPoint vertices[],
+                                       const SkPoint texs[], const SkColor colors[], SkBlendMode blendMode,
+                                       const uint16_t indices[], int indexCount, const SkPaint& paint) {
+        addOp(DRAW_VERTICES);
+        add(mode);
+        add(vertices, vertexCount * sizeof(SkPoint));
+        if (texs) {
+            add(texs, vertexCount * sizeof(SkPoint));
+        }
+        if (colors) {
+            add(colors, vertexCount * sizeof(SkColor));
+        }
+        add(blendMode);
+        if (indices) {
+            add(indices, indexCount * sizeof(uint16_t));
+        }
+        addPaint(&paint);
+    }
+
+    void PictureHasher::onDrawPatch(const SkPoint cubics[12], const SkColor colors[4], const SkPoint texCoords[4],
+                                    SkBlendMode mode, const SkPaint& paint) {
+        addOp(DRAW_PATCH);
+        add(cubics, 12 * sizeof(SkPoint));
+        if (colors) {
+            add(colors, 4 * sizeof(SkColor));
+        }
+        if (texCoords) {
+            add(texCoords, 4 * sizeof(SkPoint));
+        }
+        add(mode);
+        addPaint(&paint);
+    }
+
+    void PictureHasher::onDrawPicture(const SkPicture* picture, const SkMatrix* matrix, const SkPaint* paint) {
+        // Pictures are immutable, their unique IDs identify the content.
+        addOp(DRAW_PICTURE);
+        add(picture->uniqueID());
+        addMatrix(matrix);
+        addPaint(paint);
+    }
+
+    void PictureHasher::onDrawDrawable(SkDrawable* drawable, const SkMatrix* matrix) {
+        // A drawable may produce different content every time it is drawn.
+        cacheable = false;
+    }
+}
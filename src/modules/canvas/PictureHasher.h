@@ -0,0 +1,143 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017-present, cyder.org
+//  All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in the
+//  Software without restriction, including without limitation the rights to use, copy,
+//  modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//  and to permit persons to whom the Software is furnished to do so, subject to the
+//  following conditions:
+//
+//      The above copyright notice and this permission notice shall be included in all
+//      copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED *AS IS*, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//  PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CYDER_PICTUREHASHER_H
+#define CYDER_PICTUREHASHER_H
+
+#include <skia.h>
+
+namespace cyder {
+
+    /**
+     * A canvas that draws nothing but folds every command played into it into a 64-bit fingerprint. Two pictures with
+     * the same fingerprint produce the same pixels, which allows a cached raster of a recording to be reused.
+     *
+     * Images, text blobs and pictures are identified by their unique IDs, paths and bitmaps by their generation IDs,
+     * so the fingerprint never reads back pixels. Paints are hashed by their fields. Paints with effects (shaders,
+     * filters, path effects...) and commands whose output may change without their arguments changing (e.g.
+     * drawables) mark the picture as not cacheable.
+     */
+    class PictureHasher : public SkNoDrawCanvas {
+    public:
+        /**
+         * Computes the fingerprint of the specified picture.
+         * @param picture The picture to hash.
+         * @param result On success, receives the fingerprint.
+         * @returns false if the picture contains commands that can not be fingerprinted.
+         */
+        static bool Hash(const SkPicture* picture, uint64_t* result);
+
+    protected:
+        void willSave() override;
+        SaveLayerStrategy getSaveLayerStrategy(const SaveLayerRec& rec) override;
+        void willRestore() override;
+
+        void didConcat(const SkMatrix& matrix) override;
+        void didSetMatrix(const SkMatrix& matrix) override;
+        void didTranslate(SkScalar dx, SkScalar dy) override;
+
+        void onClipRect(const SkRect& rect, SkClipOp op, ClipEdgeStyle edgeStyle) override;
+        void onClipRRect(const SkRRect& rrect, SkClipOp op, ClipEdgeStyle edgeStyle) override;
+        void onClipPath(const SkPath& path, SkClipOp op, ClipEdgeStyle edgeStyle) override;
+        void onClipRegion(const SkRegion& region, SkClipOp op) override;
+
+        void onDrawAnnotation(const SkRect& rect, const char key[], SkData* value) override;
+        void onDrawPaint(const SkPaint& paint) override;
+        void onDrawPoints(PointMode mode, size_t count, const SkPoint pts[], const SkPaint& paint) override;
+        void onDrawRect(const SkRect& rect, const SkPaint& paint) override;
+        void onDrawRegion(const SkRegion& region, const SkPaint& paint) override;
+        void onDrawOval(const SkRect& rect, const SkPaint& paint) override;
+        void onDrawArc(const SkRect& rect, SkScalar startAngle, SkScalar sweepAngle, bool useCenter,
+                       const SkPaint& paint) override;
+        void onDrawRRect(const SkRRect& rrect, const SkPaint& paint) override;
+        void onDrawDRRect(const SkRRect& outer, const SkRRect& inner, const SkPaint& paint) override;
+        void onDrawPath(const SkPath& path, const SkPaint& paint) override;
+
+        void onDrawText(const void* text, size_t byteLength, SkScalar x, SkScalar y, const SkPaint& paint) override;
+        void onDrawPosText(const void* text, size_t byteLength, const SkPoint pos[], const SkPaint& paint) override;
+        void onDrawPosTextH(const void* text, size_t byteLength, const SkScalar xpos[], SkScalar constY,
+                            const SkPaint& paint) override;
+        void onDrawTextOnPath(const void* text, size_t byteLength, const SkPath& path, const SkMatrix* matrix,
+                              const SkPaint& paint) override;
+        void onDrawTextRSXform(const void* text, size_t byteLength, const SkRSXform xform[], const SkRect* cullRect,
+                               const SkPaint& paint) override;
+        void onDrawTextBlob(const SkTextBlob* blob, SkScalar x, SkScalar y, const SkPaint& paint) override;
+
+        void onDrawImage(const SkImage* image, SkScalar x, SkScalar y, const SkPaint* paint) override;
+        void onDrawImageRect(const SkImage* image, const SkRect* src, const SkRect& dst, const SkPaint* paint,
+                             SrcRectConstraint constraint) override;
+        void onDrawImageNine(const SkImage* image, const SkIRect& center, const SkRect& dst,
+                             const SkPaint* paint) override;
+        void onDrawImageLattice(const SkImage* image, const Lattice& lattice, const SkRect& dst,
+                                const SkPaint* paint) override;
+        void onDrawBitmap(const SkBitmap& bitmap, SkScalar x, SkScalar y, const SkPaint* paint) override;
+        void onDrawBitmapRect(const SkBitmap& bitmap, const SkRect* src, const SkRect& dst, const SkPaint* paint,
+                              SrcRectConstraint constraint) override;
+        void onDrawBitmapNine(const SkBitmap& bitmap, const SkIRect& center, const SkRect& dst,
+                              const SkPaint* paint) override;
+        void onDrawBitmapLattice(const SkBitmap& bitmap, const Lattice& lattice, const SkRect& dst,
+                                 const SkPaint* paint) override;
+
+        void onDrawAtlas(const SkImage* atlas, const SkRSXform xform[], const SkRect tex[], const SkColor colors[],
+                         int count, SkBlendMode mode, const SkRect* cullRect, const SkPaint* paint) override;
+        void onDrawVertices(VertexMode mode, int vertexCount, const SkPoint vertices[], const SkPoint texs[],
+                            const SkColor colors[], SkBlendMode blendMode, const uint16_t indices[], int indexCount,
+                            const SkPaint& paint) override;
+        void onDrawPatch(const SkPoint cubics[12], const SkColor colors[4], const SkPoint texCoords[4],
+                         SkBlendMode mode, const SkPaint& paint) override;
+        void onDrawPicture(const SkPicture* picture, const SkMatrix* matrix, const SkPaint* paint) override;
+        void onDrawDrawable(SkDrawable* drawable, const SkMatrix* matrix) override;
+
+    private:
+        uint64_t hash = 14695981039346656037ULL;
+        bool cacheable = true;
+
+        PictureHasher(int width, int height) : SkNoDrawCanvas(width, height) {
+        }
+
+        void add(const void* data, size_t length);
+
+        template<typename T>
+        void add(const T& value) {
+            add(&value, sizeof(T));
+        }
+
+        void addOp(int op) {
+            add(op);
+        }
+
+        void addPaint(const SkPaint* paint);
+        void addMatrix(const SkMatrix* matrix);
+        void addRRect(const SkRRect& rrect);
+        void addRegion(const SkRegion& region);
+        void addImage(const SkImage* image);
+        void addBitmap(const SkBitmap& bitmap);
+        void addRect(const SkRect* rect);
+    };
+
+}
+
+#endif //CYDER_PICTUREHASHER_H
@@ -0,0 +1,193 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017-present, cyder.org
+//  All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in the
+//  Software without restriction, including without limitation the rights to use, copy,
+//  modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//  and to permit persons to whom the Software is furnished to do so, subject to the
+//  following conditions:
+//
+//      The above copyright notice and this permission notice shall be included in all
+//      copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED *AS IS*, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//  PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "CSSColor.h"
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+namespace cyder {
+
+    namespace {
+        struct NamedColor {
+            const char* name;
+            SkColor color;
+        };
+
+        const NamedColor namedColors[] = {
+                {"black",       0xFF000000},
+                {"silver",      0xFFC0C0C0},
+                {"gray",        0xFF808080},
+                {"grey",        0xFF808080},
+                {"white",       0xFFFFFFFF},
+                {"maroon",      0xFF800000},
+                {"red",         0xFFFF0000},
+                {"purple",      0xFF800080},
+                {"fuchsia",     0xFFFF00FF},
+                {"magenta",     0xFFFF00FF},
+                {"green",       0xFF008000},
+                {"lime",        0xFF00FF00},
+                {"olive",       0xFF808000},
+                {"yellow",      0xFFFFFF00},
+                {"navy",        0xFF000080},
+                {"blue",        0xFF0000FF},
+                {"teal",        0xFF008080},
+                {"aqua",        0xFF00FFFF},
+                {"cyan",        0xFF00FFFF},
+                {"orange",      0xFFFFA500},
+                {"transparent", 0x00000000}
+        };
+
+        int hexValue(char c) {
+            if (c >= '0' && c <= '9') {
+                return c - '0';
+            }
+            c = static_cast<char>(std::tolower(c));
+            if (c >= 'a' && c <= 'f') {
+                return c - 'a' + 10;
+            }
+            return -1;
+        }
+
+        bool parseHexColor(const std::string& text, SkColor* color) {
+            auto length = text.length() - 1;
+            if (length != 3 && length != 4 && length != 6 && length != 8) {
+                return false;
+            }
+            int values[8];
+            for (size_t i = 0; i < length; i++) {
+                values[i] = hexValue(text[i + 1]);
+                if (values[i] < 0) {
+                    return false;
+                }
+            }
+            unsigned channels[4] = {0, 0, 0, 255};
+            if (length <= 4) {
+                for (size_t i = 0; i < length; i++) {
+                    channels[i] = static_cast<unsigned>(values[i] * 17);
+                }
+            } else {
+                for (size_t i = 0; i < length / 2; i++) {
+                    channels[i] = static_cast<unsigned>(values[i * 2] * 16 + values[i * 2 + 1]);
+                }
+            }
+            *color = SkColorSetARGB(channels[3], channels[0], channels[1], channels[2]);
+            return true;
+        }
+
+        bool parseFunctionalColor(const std::string& text, SkColor* color) {
+            auto open = text.find('(');
+            if (open == std::string::npos || text.back() != ')') {
+                return false;
+            }
+            auto name = text.substr(0, open);
+            bool hasAlpha = name == "rgba";
+            if (!hasAlpha && name != "rgb") {
+                return false;
+            }
+            double values[4] = {0, 0, 0, 1};
+            int count = hasAlpha ? 4 : 3;
+            auto cursor = text.c_str() + open + 1;
+            for (int i = 0; i < count; i++) {
+                char* end;
+                values[i] = std::strtod(cursor, &end);
+                if (end == cursor || !std::isfinite(values[i])) {
+                    return false;
+                }
+                cursor = end;
+                while (std::isspace(*cursor)) {
+                    cursor++;
+                }
+                if (i < 3 && *cursor == '%') {
+                    values[i] *= 2.55;
+                    cursor++;
+                    while (std::isspace(*cursor)) {
+                        cursor++;
+                    }
+                }
+                char expected = i == count - 1 ? ')' : ',';
+                if (*cursor != expected) {
+                    return false;
+                }
+                cursor++;
+            }
+            if (*cursor != '\0') {
+                return false;
+            }
+            unsigned channels[4];
+            for (int i = 0; i < 3; i++) {
+                channels[i] = static_cast<unsigned>(std::round(std::fmin(std::fmax(values[i], 0), 255)));
+            }
+            channels[3] = static_cast<unsigned>(std::round(std::fmin(std::fmax(values[3], 0), 1) * 255));
+            *color = SkColorSetARGB(channels[3], channels[0], channels[1], channels[2]);
+            return true;
+        }
+    }
+
+    bool ParseCSSColor(const std::string& text, SkColor* color) {
+        std::string value;
+        value.reserve(text.length());
+        for (auto c : text) {
+            if (!std::isspace(static_cast<unsigned char>(c)) || (!value.empty() && value.back() != ' ')) {
+                value.push_back(std::isspace(static_cast<unsigned char>(c)) ? ' ' :
+                                static_cast<char>(std::tolower(static_cast<unsigned char>(c))));
+            }
+        }
+        while (!value.empty() && value.back() == ' ') {
+            value.pop_back();
+        }
+        if (value.empty()) {
+            return false;
+        }
+        if (value[0] == '#') {
+            return parseHexColor(value, color);
+        }
+        if (value.back() == ')') {
+            return parseFunctionalColor(value, color);
+        }
+        for (auto& namedColor : namedColors) {
+            if (value == namedColor.name) {
+                *color = namedColor.color;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::string SerializeCSSColor(SkColor color) {
+        char buffer[32];
+        auto alpha = SkColorGetA(color);
+        if (alpha == 255) {
+            snprintf(buffer, sizeof(buffer), "#%02x%02x%02x", SkColorGetR(color), SkColorGetG(color),
+                     SkColorGetB(color));
+        } else {
+            snprintf(buffer, sizeof(buffer), "rgba(%u, %u, %u, %g)", SkColorGetR(color), SkColorGetG(color),
+                     SkColorGetB(color), std::round(alpha / 255.0 * 1000) / 1000);
+        }
+        return buffer;
+    }
+}
@@ -0,0 +1,52 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017-present, cyder.org
+//  All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in the
+//  Software without restriction, including without limitation the rights to use, copy,
+//  modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//  and to permit persons to whom the Software is furnished to do so, subject to the
+//  following conditions:
+//
+//      The above copyright notice and this permission notice shall be included in all
+//      copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED *AS IS*, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//  PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CYDER_CSSCOLOR_H
+#define CYDER_CSSCOLOR_H
+
+#include <string>
+#include <skia.h>
+
+namespace cyder {
+
+    /**
+     * Parses a CSS color string. Supports the hexadecimal notations (#rgb, #rgba, #rrggbb and #rrggbbaa), the rgb() and
+     * rgba() functional notations, and the basic named colors.
+     * @param text The CSS color string to parse.
+     * @param color On success, receives the parsed color.
+     * @returns false if the text is not a supported color.
+     */
+    bool ParseCSSColor(const std::string& text, SkColor* color);
+
+    /**
+     * Serializes a color the way CanvasRenderingContext2D reports colors: "#rrggbb" for opaque colors and
+     * "rgba(r, g, b, a)" otherwise.
+     */
+    std::string SerializeCSSColor(SkColor color);
+
+}
+
+#endif //CYDER_CSSCOLOR_H
@@ -0,0 +1,153 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017-present, cyder.org
+//  All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in the
+//  Software without restriction, including without limitation the rights to use, copy,
+//  modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//  and to permit persons to whom the Software is furnished to do so, subject to the
+//  following conditions:
+//
+//      The above copyright notice and this permission notice shall be included in all
+//      copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED *AS IS*, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//  PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CYDER_CANVASCOMMAND_H
+#define CYDER_CANVASCOMMAND_H
+
+namespace cyder {
+
+    /**
+     * The command types of an encoded command buffer. A command is stored as its type followed by its arguments, all of
+     * them are floats. Images and strings are referenced by their indices in the image list and the string list
+     * submitted along with the buffer.
+     * Note: Keep in sync with the CommandType enum in scripts/src/display/CommandBuffer.ts.
+     */
+    enum class CanvasCommand {
+        /**
+         * Arguments: image, targetX, targetY
+         */
+        DRAW_IMAGE = 1,
+        /**
+         * Arguments: image, targetX, targetY, targetWidth, targetHeight
+         */
+        DRAW_IMAGE_RECT = 2,
+        /**
+         * Arguments: image, sourceX, sourceY, sourceWidth, sourceHeight, targetX, targetY, targetWidth, targetHeight
+         */
+        DRAW_IMAGE_SUB_RECT = 3,
+        SAVE = 4,
+        RESTORE = 5,
+        /**
+         * Arguments: x, y
+         */
+        TRANSLATE = 6,
+        /**
+         * Arguments: angle
+         */
+        ROTATE = 7,
+        /**
+         * Arguments: x, y
+         */
+        SCALE = 8,
+        /**
+         * Arguments: a, b, c, d, e, f
+         */
+        TRANSFORM = 9,
+        /**
+         * Arguments: a, b, c, d, e, f
+         */
+        SET_TRANSFORM = 10,
+        RESET_TRANSFORM = 11,
+        /**
+         * Arguments: alpha
+         */
+        SET_GLOBAL_ALPHA = 12,
+        /**
+         * Arguments: the index of the operation in the composite operation table of CanvasRenderingContext2D.cpp
+         */
+        SET_GLOBAL_COMPOSITE_OPERATION = 13,
+        /**
+         * Arguments: 1 to enable, 0 to disable
+         */
+        SET_IMAGE_SMOOTHING_ENABLED = 14,
+        /**
+         * Arguments: the high and low 16 bits of the ARGB color
+         */
+        SET_FILL_COLOR = 15,
+        /**
+         * Arguments: the high and low 16 bits of the ARGB color
+         */
+        SET_STROKE_COLOR = 16,
+        /**
+         * Arguments: width
+         */
+        SET_LINE_WIDTH = 17,
+        BEGIN_PATH = 18,
+        CLOSE_PATH = 19,
+        /**
+         * Arguments: x, y
+         */
+        MOVE_TO = 20,
+        /**
+         * Arguments: x, y
+         */
+        LINE_TO = 21,
+        /**
+         * Arguments: cpx, cpy, x, y
+         */
+        QUADRATIC_CURVE_TO = 22,
+        /**
+         * Arguments: cp1x, cp1y, cp2x, cp2y, x, y
+         */
+        BEZIER_CURVE_TO = 23,
+        /**
+         * Arguments: x, y, radius, startAngle, endAngle, 1 if anticlockwise otherwise 0
+         */
+        ARC = 24,
+        /**
+         * Arguments: x, y, width, height
+         */
+        RECT = 25,
+        /**
+         * Arguments: 1 for the evenodd fill rule, 0 for nonzero
+         */
+        FILL = 26,
+        STROKE = 27,
+        /**
+         * Arguments: 1 for the evenodd fill rule, 0 for nonzero
+         */
+        CLIP = 28,
+        /**
+         * Arguments: the index of the font string
+         */
+        SET_FONT = 29,
+        /**
+         * Arguments: the index of the text alignment in the text alignment table
+         */
+        SET_TEXT_ALIGN = 30,
+        /**
+         * Arguments: the index of the text baseline in the text baseline table
+         */
+        SET_TEXT_BASELINE = 31,
+        /**
+         * Arguments: the index of the text string, x, y, maxWidth (Infinity if not specified)
+         */
+        FILL_TEXT = 32
+    };
+
+}
+
+#endif //CYDER_CANVASCOMMAND_H
@@ -0,0 +1,161 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017-present, cyder.org
+//  All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in the
+//  Software without restriction, including without limitation the rights to use, copy,
+//  modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//  and to permit persons to whom the Software is furnished to do so, subject to the
+//  following conditions:
+//
+//      The above copyright notice and this permission notice shall be included in all
+//      copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED *AS IS*, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//  PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "CanvasPath.h"
+#include <cmath>
+
+namespace cyder {
+
+    static inline bool isFinite(float a, float b) {
+        return std::isfinite(a) && std::isfinite(b);
+    }
+
+    static inline bool isFinite(float a, float b, float c, float d) {
+        return isFinite(a, b) && isFinite(c, d);
+    }
+
+    static inline SkPoint mapPoint(const SkMatrix* matrix, float x, float y) {
+        auto point = SkPoint::Make(x, y);
+        if (matrix) {
+            matrix->mapPoints(&point, 1);
+        }
+        return point;
+    }
+
+    void CanvasPath::ensureStartPoint(float x, float y) {
+        if (_path.countPoints() == 0) {
+            _path.moveTo(mapPoint(pathTransform(), x, y));
+        }
+    }
+
+    void CanvasPath::closePath() {
+        if (_path.countPoints() == 0) {
+            return;
+        }
+        _path.close();
+    }
+
+    void CanvasPath::moveTo(float x, float y) {
+        if (!isFinite(x, y)) {
+            return;
+        }
+        _path.moveTo(mapPoint(pathTransform(), x, y));
+    }
+
+    void CanvasPath::lineTo(float x, float y) {
+        if (!isFinite(x, y)) {
+            return;
+        }
+        if (_path.countPoints() == 0) {
+            moveTo(x, y);
+            return;
+        }
+        _path.lineTo(mapPoint(pathTransform(), x, y));
+    }
+
+    void CanvasPath::quadraticCurveTo(float cpx, float cpy, float x, float y) {
+        if (!isFinite(cpx, cpy, x, y)) {
+            return;
+        }
+        ensureStartPoint(cpx, cpy);
+        auto matrix = pathTransform();
+        _path.quadTo(mapPoint(matrix, cpx, cpy), mapPoint(matrix, x, y));
+    }
+
+    void CanvasPath::bezierCurveTo(float cp1x, float cp1y, float cp2x, float cp2y, float x, float y) {
+        if (!isFinite(cp1x, cp1y, cp2x, cp2y) || !isFinite(x, y)) {
+            return;
+        }
+        ensureStartPoint(cp1x, cp1y);
+        auto matrix = pathTransform();
+        _path.cubicTo(mapPoint(matrix, cp1x, cp1y), mapPoint(matrix, cp2x, cp2y), mapPoint(matrix, x, y));
+    }
+
+    static const float TwoPI = 2 * SK_ScalarPI;
+
+    bool CanvasPath::arc(float x, float y, float radius, float startAngle, float endAngle, bool anticlockwise) {
+        if (!isFinite(x, y, radius, startAngle) || !std::isfinite(endAngle)) {
+            return true;
+        }
+        if (radius < 0) {
+            return false;
+        }
+        // Clamp the sweep to a full circle, and make it go in the requested direction.
+        float sweep = endAngle - startAngle;
+        if (!anticlockwise) {
+            if (sweep >= TwoPI) {
+                sweep = TwoPI;
+            } else {
+                sweep = std::fmod(sweep, TwoPI);
+                if (sweep < 0) {
+                    sweep += TwoPI;
+                }
+            }
+        } else {
+            if (sweep <= -TwoPI) {
+                sweep = -TwoPI;
+            } else {
+                sweep = std::fmod(sweep, TwoPI);
+                if (sweep > 0) {
+                    sweep -= TwoPI;
+                }
+            }
+        }
+        auto oval = SkRect::MakeLTRB(x - radius, y - radius, x + radius, y + radius);
+        auto startDegrees = SkRadiansToDegrees(startAngle);
+        auto sweepDegrees = SkRadiansToDegrees(sweep);
+        auto matrix = pathTransform();
+        SkPath arcPath;
+        auto target = matrix ? &arcPath : &_path;
+        bool forceMoveTo = target->countPoints() == 0;
+        // SkPath can not add a full circle with a single arcTo(), split it into two halves.
+        if (std::fabs(sweepDegrees) >= 360) {
+            float half = sweepDegrees * 0.5f;
+            target->arcTo(oval, startDegrees, half, forceMoveTo);
+            target->arcTo(oval, startDegrees + half, half, false);
+        } else {
+            target->arcTo(oval, startDegrees, sweepDegrees, forceMoveTo);
+        }
+        if (matrix) {
+            arcPath.transform(*matrix);
+            auto mode = _path.countPoints() == 0 ? SkPath::kAppend_AddPathMode : SkPath::kExtend_AddPathMode;
+            _path.addPath(arcPath, mode);
+        }
+        return true;
+    }
+
+    void CanvasPath::rect(float x, float y, float width, float height) {
+        if (!isFinite(x, y, width, height)) {
+            return;
+        }
+        auto matrix = pathTransform();
+        _path.moveTo(mapPoint(matrix, x, y));
+        _path.lineTo(mapPoint(matrix, x + width, y));
+        _path.lineTo(mapPoint(matrix, x + width, y + height));
+        _path.lineTo(mapPoint(matrix, x, y + height));
+        _path.close();
+    }
+}
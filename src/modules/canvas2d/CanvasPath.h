@@ -0,0 +1,110 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017-present, cyder.org
+//  All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in the
+//  Software without restriction, including without limitation the rights to use, copy,
+//  modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//  and to permit persons to whom the Software is furnished to do so, subject to the
+//  following conditions:
+//
+//      The above copyright notice and this permission notice shall be included in all
+//      copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED *AS IS*, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//  PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CYDER_CANVASPATH_H
+#define CYDER_CANVASPATH_H
+
+#include <skia.h>
+
+namespace cyder {
+
+    /**
+     * The algorithm by which to determine if a point is inside a path or outside a path.
+     */
+    enum class CanvasFillRule {
+        NONZERO,
+        EVENODD
+    };
+
+    /**
+     * CanvasPath implements the path building methods shared by CanvasRenderingContext2D and Path2D.
+     */
+    class CanvasPath {
+    public:
+        virtual ~CanvasPath() {}
+
+        /**
+         * Returns the underlying path.
+         */
+        const SkPath& path() const {
+            return _path;
+        }
+
+        /**
+         * Causes the point of the pen to move back to the start of the current sub-path. If the shape has already been
+         * closed or has only one point, this function does nothing.
+         */
+        void closePath();
+
+        /**
+         * Moves the starting point of a new sub-path to the (x, y) coordinates.
+         */
+        void moveTo(float x, float y);
+
+        /**
+         * Connects the last point in the sub-path to the (x, y) coordinates with a straight line.
+         */
+        void lineTo(float x, float y);
+
+        /**
+         * Adds a quadratic Bézier curve to the path.
+         */
+        void quadraticCurveTo(float cpx, float cpy, float x, float y);
+
+        /**
+         * Adds a cubic Bézier curve to the path.
+         */
+        void bezierCurveTo(float cp1x, float cp1y, float cp2x, float cp2y, float x, float y);
+
+        /**
+         * Adds an arc to the path which is centered at (x, y) position with radius r starting at startAngle and ending
+         * at endAngle going in the given direction by anticlockwise.
+         * @returns false if the radius is negative, in which case the path is not changed.
+         */
+        bool arc(float x, float y, float radius, float startAngle, float endAngle, bool anticlockwise);
+
+        /**
+         * Creates a path for a rectangle at position (x, y) with a size that is determined by width and height.
+         */
+        void rect(float x, float y, float width, float height);
+
+    protected:
+        SkPath _path;
+
+        /**
+         * Returns the transform applied to the points added to the path, or nullptr if they are added as they are.
+         */
+        virtual const SkMatrix* pathTransform() const {
+            return nullptr;
+        }
+
+    private:
+        void ensureStartPoint(float x, float y);
+    };
+
+}
+
+#endif //CYDER_CANVASPATH_H
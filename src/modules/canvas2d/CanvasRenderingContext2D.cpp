@@ -25,15 +25,402 @@
 //////////////////////////////////////////////////////////////////////////////////////
 
 #include "CanvasRenderingContext2D.h"
+#include "CanvasCommand.h"
+#include "CSSColor.h"
+#include "utils/PixelConverter.h"
 #include <cmath>
+#include <cstring>
 
 namespace cyder {
     CanvasRenderingContext2D::CanvasRenderingContext2D(DrawingBuffer* buffer) : buffer(buffer) {
+        FontManager::GetInstance()->parseFont("10px sans-serif", &state.font);
     }
 
     CanvasRenderingContext2D::~CanvasRenderingContext2D() {
     }
 
+    namespace {
+        struct CompositeOperation {
+            const char* name;
+            SkBlendMode mode;
+        };
+
+        // Note: The command buffer encodes composite operations by their index in this table, keep the order in sync
+        // with COMPOSITE_OPERATIONS in scripts/src/display/CommandBuffer.ts.
+        const CompositeOperation compositeOperations[] = {
+                {"source-over",      SkBlendMode::kSrcOver},
+                {"source-in",        SkBlendMode::kSrcIn},
+                {"source-out",       SkBlendMode::kSrcOut},
+                {"source-atop",      SkBlendMode::kSrcATop},
+                {"destination-over", SkBlendMode::kDstOver},
+                {"destination-in",   SkBlendMode::kDstIn},
+                {"destination-out",  SkBlendMode::kDstOut},
+                {"destination-atop", SkBlendMode::kDstATop},
+                {"lighter",          SkBlendMode::kPlus},
+                {"copy",             SkBlendMode::kSrc},
+                {"xor",              SkBlendMode::kXor},
+                {"multiply",         SkBlendMode::kMultiply},
+                {"screen",           SkBlendMode::kScreen},
+                {"overlay",          SkBlendMode::kOverlay},
+                {"darken",           SkBlendMode::kDarken},
+                {"lighten",          SkBlendMode::kLighten},
+                {"color-dodge",      SkBlendMode::kColorDodge},
+                {"color-burn",       SkBlendMode::kColorBurn},
+                {"hard-light",       SkBlendMode::kHardLight},
+                {"soft-light",       SkBlendMode::kSoftLight},
+                {"difference",       SkBlendMode::kDifference},
+                {"exclusion",        SkBlendMode::kExclusion},
+                {"hue",              SkBlendMode::kHue},
+                {"saturation",       SkBlendMode::kSaturation},
+                {"color",            SkBlendMode::kColor},
+                {"luminosity",       SkBlendMode::kLuminosity}
+        };
+
+        const size_t compositeOperationCount = sizeof(compositeOperations) / sizeof(compositeOperations[0]);
+
+        // Note: The command buffer encodes the text alignments and baselines by their indices in these tables, keep
+        // the order in sync with TEXT_ALIGNS and TEXT_BASELINES in scripts/src/display/CommandBuffer.ts.
+        const char* textAligns[] = {"start", "end", "left", "right", "center"};
+        const size_t textAlignCount = sizeof(textAligns) / sizeof(textAligns[0]);
+        const char* textBaselines[] = {"top", "hanging", "middle", "alphabetic", "ideographic", "bottom"};
+        const size_t textBaselineCount = sizeof(textBaselines) / sizeof(textBaselines[0]);
+    }
+
+    void CanvasRenderingContext2D::setGlobalAlpha(float value) {
+        if (!(value >= 0 && value <= 1)) {
+            return;
+        }
+        state.globalAlpha = value;
+    }
+
+    std::string CanvasRenderingContext2D::globalCompositeOperation() const {
+        for (auto& operation : compositeOperations) {
+            if (operation.mode == state.globalCompositeOperation) {
+                return operation.name;
+            }
+        }
+        return compositeOperations[0].name;
+    }
+
+    void CanvasRenderingContext2D::setGlobalCompositeOperation(const std::string& value) {
+        for (auto& operation : compositeOperations) {
+            if (value == operation.name) {
+                state.globalCompositeOperation = operation.mode;
+                return;
+            }
+        }
+    }
+
+    std::string CanvasRenderingContext2D::fillStyle() const {
+        return SerializeCSSColor(state.fillColor);
+    }
+
+    void CanvasRenderingContext2D::setFillStyle(const std::string& value) {
+        ParseCSSColor(value, &state.fillColor);
+    }
+
+    std::string CanvasRenderingContext2D::strokeStyle() const {
+        return SerializeCSSColor(state.strokeColor);
+    }
+
+    void CanvasRenderingContext2D::setStrokeStyle(const std::string& value) {
+        ParseCSSColor(value, &state.strokeColor);
+    }
+
+    void CanvasRenderingContext2D::setLineWidth(float value) {
+        if (!std::isfinite(value) || value <= 0) {
+            return;
+        }
+        state.lineWidth = value;
+    }
+
+    void CanvasRenderingContext2D::setFont(const std::string& value) {
+        FontManager::GetInstance()->parseFont(value, &state.font);
+    }
+
+    std::string CanvasRenderingContext2D::textAlign() const {
+        return textAligns[static_cast<size_t>(state.textAlign)];
+    }
+
+    void CanvasRenderingContext2D::setTextAlign(const std::string& value) {
+        for (size_t i = 0; i < textAlignCount; i++) {
+            if (value == textAligns[i]) {
+                state.textAlign = static_cast<CanvasTextAlign>(i);
+                return;
+            }
+        }
+    }
+
+    std::string CanvasRenderingContext2D::textBaseline() const {
+        return textBaselines[static_cast<size_t>(state.textBaseline)];
+    }
+
+    void CanvasRenderingContext2D::setTextBaseline(const std::string& value) {
+        for (size_t i = 0; i < textBaselineCount; i++) {
+            if (value == textBaselines[i]) {
+                state.textBaseline = static_cast<CanvasTextBaseline>(i);
+                return;
+            }
+        }
+    }
+
+    void CanvasRenderingContext2D::save() {
+        stateStack.push_back(state);
+    }
+
+    void CanvasRenderingContext2D::restore() {
+        if (stateStack.empty()) {
+            return;
+        }
+        state = stateStack.back();
+        stateStack.pop_back();
+    }
+
+    void CanvasRenderingContext2D::translate(float x, float y) {
+        if (!std::isfinite(x) || !std::isfinite(y)) {
+            return;
+        }
+        state.matrix.preTranslate(x, y);
+    }
+
+    void CanvasRenderingContext2D::rotate(float angle) {
+        if (!std::isfinite(angle)) {
+            return;
+        }
+        state.matrix.preRotate(SkRadiansToDegrees(angle));
+    }
+
+    void CanvasRenderingContext2D::scale(float x, float y) {
+        if (!std::isfinite(x) || !std::isfinite(y)) {
+            return;
+        }
+        state.matrix.preScale(x, y);
+    }
+
+    void CanvasRenderingContext2D::transform(float a, float b, float c, float d, float e, float f) {
+        if (!std::isfinite(a) || !std::isfinite(b) || !std::isfinite(c) || !std::isfinite(d) ||
+            !std::isfinite(e) || !std::isfinite(f)) {
+            return;
+        }
+        state.matrix.preConcat(SkMatrix::MakeAll(a, c, e, b, d, f, 0, 0, 1));
+    }
+
+    void CanvasRenderingContext2D::setTransform(float a, float b, float c, float d, float e, float f) {
+        if (!std::isfinite(a) || !std::isfinite(b) || !std::isfinite(c) || !std::isfinite(d) ||
+            !std::isfinite(e) || !std::isfinite(f)) {
+            return;
+        }
+        state.matrix.setAll(a, c, e, b, d, f, 0, 0, 1);
+    }
+
+    void CanvasRenderingContext2D::resetTransform() {
+        state.matrix.reset();
+    }
+
+    SkCanvas* CanvasRenderingContext2D::getCanvas(const SkRect& bounds, const SkMatrix* matrix) {
+        if (!matrix) {
+            matrix = &state.matrix;
+        }
+        SkRect deviceBounds;
+        matrix->mapRect(&deviceBounds, bounds);
+        // Also keeps the bounds in the range of integers before rounding them.
+        if (!deviceBounds.intersect(SkRect::MakeIWH(buffer->width(), buffer->height()))) {
+            deviceBounds.setEmpty();
+        }
+        for (auto& path : state.clipPaths) {
+            if (!deviceBounds.intersect(path.getBounds())) {
+                deviceBounds.setEmpty();
+                break;
+            }
+        }
+        SkIRect dirtyRect;
+        deviceBounds.roundOut(&dirtyRect);
+        // Leave room for the anti-aliased edges.
+        dirtyRect.outset(1, 1);
+        auto canvas = buffer->getCanvasForRect(dirtyRect);
+        // The clip lives in one save level above the base one. A new canvas, even at the address of the old one,
+        // has no save level, so it is detected by the save count too.
+        int expectedSaveCount = appliedClipID ? 2 : 1;
+        if (canvas != clippedCanvas || state.clipID != appliedClipID || canvas->getSaveCount() != expectedSaveCount) {
+            canvas->restoreToCount(1);
+            if (!state.clipPaths.empty()) {
+                canvas->save();
+                canvas->resetMatrix();
+                for (auto& path : state.clipPaths) {
+                    canvas->clipPath(path, true);
+                }
+            }
+            clippedCanvas = canvas;
+            appliedClipID = state.clipID;
+        }
+        canvas->setMatrix(*matrix);
+        return canvas;
+    }
+
+    SkPaint CanvasRenderingContext2D::makeShapePaint(SkColor color, SkPaint::Style style) const {
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        paint.setStyle(style);
+        paint.setColor(color);
+        if (state.globalAlpha != 1) {
+            paint.setAlpha(static_cast<U8CPU>(std::round(SkColorGetA(color) * state.globalAlpha)));
+        }
+        paint.setBlendMode(state.globalCompositeOperation);
+        if (style == SkPaint::kStroke_Style) {
+            paint.setStrokeWidth(state.lineWidth);
+        }
+        return paint;
+    }
+
+    static inline SkPath::FillType ToFillType(CanvasFillRule fillRule) {
+        return fillRule == CanvasFillRule::EVENODD ? SkPath::kEvenOdd_FillType : SkPath::kWinding_FillType;
+    }
+
+    void CanvasRenderingContext2D::beginPath() {
+        _path.rewind();
+    }
+
+    void CanvasRenderingContext2D::fill(CanvasFillRule fillRule) {
+        // The current path is already in device space.
+        fillPath(_path, &SkMatrix::I(), fillRule);
+    }
+
+    void CanvasRenderingContext2D::fill(const Path2D* path, CanvasFillRule fillRule) {
+        fillPath(path->path(), nullptr, fillRule);
+    }
+
+    void CanvasRenderingContext2D::fillPath(const SkPath& path, const SkMatrix* matrix, CanvasFillRule fillRule) {
+        if (path.isEmpty()) {
+            return;
+        }
+        auto fillType = ToFillType(fillRule);
+        auto paint = makeShapePaint(state.fillColor, SkPaint::kFill_Style);
+        auto& bounds = path.getBounds();
+        if (path.getFillType() == fillType) {
+            getCanvas(bounds, matrix)->drawPath(path, paint);
+        } else {
+            // Copying a path shares its geometry, only the fill type differs.
+            SkPath filledPath(path);
+            filledPath.setFillType(fillType);
+            getCanvas(bounds, matrix)->drawPath(filledPath, paint);
+        }
+    }
+
+    void CanvasRenderingContext2D::stroke() {
+        if (state.matrix.isIdentity()) {
+            strokePath(_path, nullptr);
+            return;
+        }
+        // The current path is in device space, but the line width is in user space. Map the path back to user space
+        // and stroke it with the current transform.
+        SkMatrix inverse;
+        if (!state.matrix.invert(&inverse)) {
+            return;
+        }
+        SkPath path;
+        _path.transform(inverse, &path);
+        strokePath(path, nullptr);
+    }
+
+    void CanvasRenderingContext2D::stroke(const Path2D* path) {
+        strokePath(path->path(), nullptr);
+    }
+
+    void CanvasRenderingContext2D::strokePath(const SkPath& path, const SkMatrix* matrix) {
+        if (path.isEmpty()) {
+            return;
+        }
+        auto paint = makeShapePaint(state.strokeColor, SkPaint::kStroke_Style);
+        SkRect storage;
+        auto& bounds = paint.computeFastStrokeBounds(path.getBounds(), &storage);
+        getCanvas(bounds, matrix)->drawPath(path, paint);
+    }
+
+    void CanvasRenderingContext2D::clip(CanvasFillRule fillRule) {
+        clipPath(_path, fillRule);
+    }
+
+    void CanvasRenderingContext2D::clip(const Path2D* path, CanvasFillRule fillRule) {
+        SkPath devicePath;
+        path->path().transform(state.matrix, &devicePath);
+        clipPath(devicePath, fillRule);
+    }
+
+    void CanvasRenderingContext2D::clipPath(SkPath path, CanvasFillRule fillRule) {
+        path.setFillType(ToFillType(fillRule));
+        state.clipPaths.push_back(path);
+        state.clipID = ++lastClipID;
+    }
+
+    void CanvasRenderingContext2D::fillText(const std::string& text, float x, float y, float maxWidth) {
+        if (!std::isfinite(x) || !std::isfinite(y) || !(maxWidth > 0)) {
+            return;
+        }
+        auto run = FontManager::GetInstance()->getTextRun(state.font, text);
+        if (!run.blob) {
+            return;
+        }
+        auto& font = state.font;
+        float offsetX = 0;
+        switch (state.textAlign) {
+            case CanvasTextAlign::END:
+            case CanvasTextAlign::RIGHT:
+                offsetX = -run.width;
+                break;
+            case CanvasTextAlign::CENTER:
+                offsetX = -run.width / 2;
+                break;
+            default:
+                break;
+        }
+        float offsetY = 0;
+        switch (state.textBaseline) {
+            case CanvasTextBaseline::TOP:
+                offsetY = font.ascent;
+                break;
+            case CanvasTextBaseline::HANGING:
+                // Fonts rarely provide a hanging baseline, approximate it like most of the browsers do.
+                offsetY = font.ascent * 0.8f;
+                break;
+            case CanvasTextBaseline::MIDDLE:
+                offsetY = (font.ascent - font.descent) / 2;
+                break;
+            case CanvasTextBaseline::IDEOGRAPHIC:
+            case CanvasTextBaseline::BOTTOM:
+                offsetY = -font.descent;
+                break;
+            default:
+                break;
+        }
+        auto paint = makeShapePaint(state.fillColor, SkPaint::kFill_Style);
+        if (run.width <= maxWidth) {
+            auto bounds = run.blob->bounds().makeOffset(x + offsetX, y + offsetY);
+            getCanvas(bounds)->drawTextBlob(run.blob, x + offsetX, y + offsetY, paint);
+            return;
+        }
+        // Condense the text horizontally around the anchor point to fit in maxWidth.
+        SkMatrix matrix = state.matrix;
+        matrix.preTranslate(x, y);
+        matrix.preScale(maxWidth / run.width, 1);
+        auto bounds = run.blob->bounds().makeOffset(offsetX, offsetY);
+        getCanvas(bounds, &matrix)->drawTextBlob(run.blob, offsetX, offsetY, paint);
+    }
+
+    float CanvasRenderingContext2D::measureText(const std::string& text) {
+        return FontManager::GetInstance()->getTextRun(state.font, text).width;
+    }
+
+    const SkPaint* CanvasRenderingContext2D::getImagePaint(SkPaint* paint) const {
+        if (state.globalAlpha == 1 && state.globalCompositeOperation == SkBlendMode::kSrcOver &&
+            !state.imageSmoothingEnabled) {
+            return nullptr;
+        }
+        paint->setAlpha(static_cast<U8CPU>(std::round(state.globalAlpha * 255)));
+        paint->setBlendMode(state.globalCompositeOperation);
+        paint->setFilterQuality(state.imageSmoothingEnabled ? kLow_SkFilterQuality : kNone_SkFilterQuality);
+        return paint;
+    }
+
     static inline SkRect normalizeRect(const SkRect& rect) {
         return SkRect::MakeXYWH(std::min(rect.fLeft, rect.fRight),
                                 std::min(rect.fTop, rect.fBottom),
@@ -84,6 +471,334 @@ namespace cyder {
         if (srcRect.isEmpty()) {
             return;
         }
-        image->draw(buffer->getCanvas(), dstRect, srcRect);
+        SkPaint paint;
+        image->draw(getCanvas(dstRect), dstRect, srcRect, getImagePaint(&paint));
+    }
+
+    void CanvasRenderingContext2D::drawImageBatch(CanvasImageSource* image, const float* transforms,
+                                                  const float* srcRects, const SkColor* colors, int count) {
+        if (!image || !image->width() || !image->height() || count <= 0) {
+            return;
+        }
+        // SkRSXform has the same layout as four consecutive floats, so the transforms are passed through as they are.
+        auto xforms = reinterpret_cast<const SkRSXform*>(transforms);
+        // Reuse the rect storage between calls, large batches are issued every frame.
+        batchRects.resize(static_cast<size_t>(count));
+        auto rects = batchRects.data();
+        SkRect bounds = SkRect::MakeEmpty();
+        SkPoint quad[4];
+        for (int i = 0; i < count; i++) {
+            auto rect = srcRects + i * 4;
+            rects[i].setXYWH(rect[0], rect[1], rect[2], rect[3]);
+            xforms[i].toQuad(rect[2], rect[3], quad);
+            SkRect spriteBounds;
+            spriteBounds.set(quad, 4);
+            bounds.join(spriteBounds);
+        }
+        SkPaint paint;
+        image->drawAtlas(getCanvas(bounds), xforms, rects, colors, count, getImagePaint(&paint));
+    }
+
+    static inline bool IsSupportedPixmap(const SkPixmap& pixmap) {
+        return pixmap.colorType() == kRGBA_8888_SkColorType || pixmap.colorType() == kBGRA_8888_SkColorType;
+    }
+
+    bool CanvasRenderingContext2D::getImageData(int x, int y, int width, int height, void* pixels) {
+        if (width <= 0 || height <= 0) {
+            return false;
+        }
+        auto bufferRect = SkIRect::MakeWH(buffer->width(), buffer->height());
+        auto rect = SkIRect::MakeXYWH(x, y, width, height);
+        if (!bufferRect.contains(rect)) {
+            memset(pixels, 0, static_cast<size_t>(width) * height * 4);
+            if (!rect.intersect(bufferRect)) {
+                return true;
+            }
+        }
+        SkPixmap pixmap;
+        if (!buffer->peekPixels(&pixmap, nullptr) || !IsSupportedPixmap(pixmap)) {
+            auto info = SkImageInfo::Make(width, height, kRGBA_8888_SkColorType, kUnpremul_SkAlphaType);
+            return buffer->readPixels(info, pixels, static_cast<size_t>(width) * 4, x, y);
+        }
+        bool swapRB = pixmap.colorType() == kBGRA_8888_SkColorType;
+        auto dst = static_cast<uint32_t*>(pixels);
+        for (int row = rect.fTop; row < rect.fBottom; row++) {
+            auto src = pixmap.addr32(rect.fLeft, row);
+            PixelConverter::Unpremultiply(src, dst + (row - y) * width + (rect.fLeft - x), rect.width(), swapRB);
+        }
+        return true;
+    }
+
+    void CanvasRenderingContext2D::putImageData(const void* pixels, int width, int height, int dx, int dy,
+                                                int dirtyX, int dirtyY, int dirtyWidth, int dirtyHeight) {
+        if (width <= 0 || height <= 0) {
+            return;
+        }
+        auto rect = SkIRect::MakeXYWH(dirtyX, dirtyY, dirtyWidth, dirtyHeight);
+        rect.sort();
+        if (!rect.intersect(SkIRect::MakeWH(width, height))) {
+            return;
+        }
+        // Clip the source rectangle to the part that lands in the buffer.
+        rect.offset(dx, dy);
+        if (!rect.intersect(SkIRect::MakeWH(buffer->width(), buffer->height()))) {
+            return;
+        }
+        auto dirtyRect = rect;
+        rect.offset(-dx, -dy);
+        auto src = static_cast<const uint32_t*>(pixels) + rect.fTop * width + rect.fLeft;
+        SkPixmap pixmap;
+        if (!buffer->peekPixels(&pixmap, &dirtyRect) || !IsSupportedPixmap(pixmap)) {
+            auto info = SkImageInfo::Make(rect.width(), rect.height(), kRGBA_8888_SkColorType, kUnpremul_SkAlphaType);
+            buffer->writePixels(info, src, static_cast<size_t>(width) * 4, rect.fLeft + dx, rect.fTop + dy);
+            return;
+        }
+        bool swapRB = pixmap.colorType() == kBGRA_8888_SkColorType;
+        for (int row = 0; row < rect.height(); row++) {
+            auto dst = pixmap.writable_addr32(rect.fLeft + dx, rect.fTop + dy + row);
+            PixelConverter::Premultiply(src + row * width, dst, rect.width(), swapRB);
+        }
+    }
+
+    static inline CanvasImageSource* GetImage(float index, CanvasImageSource* const images[], size_t imageCount) {
+        if (!(index >= 0 && index < imageCount)) {
+            return nullptr;
+        }
+        return images[static_cast<size_t>(index)];
+    }
+
+    static inline bool ToColor(float high, float low, SkColor* color) {
+        // Converting a NaN or an out of range float to an integer is undefined, reject them as malformed.
+        if (!(high >= 0 && high <= 0xFFFF && low >= 0 && low <= 0xFFFF)) {
+            return false;
+        }
+        *color = (static_cast<SkColor>(high) << 16) | static_cast<SkColor>(low);
+        return true;
+    }
+
+    static inline const std::string* GetText(float index, const std::string texts[], size_t textCount) {
+        if (!(index >= 0 && index < textCount)) {
+            return nullptr;
+        }
+        return texts + static_cast<size_t>(index);
+    }
+
+    bool CanvasRenderingContext2D::executeCommands(const float* commands, size_t length,
+                                                   CanvasImageSource* const images[], size_t imageCount,
+                                                   const std::string texts[], size_t textCount) {
+        size_t index = 0;
+        CanvasImageSource* image;
+        const std::string* text;
+        while (index < length) {
+            auto type = commands[index++];
+            if (!(type >= 0 && type <= 0xFFFF)) {
+                return false;
+            }
+            auto command = static_cast<CanvasCommand>(static_cast<int>(type));
+            auto args = commands + index;
+            auto remaining = length - index;
+            switch (command) {
+                case CanvasCommand::DRAW_IMAGE:
+                    if (remaining < 3 || !(image = GetImage(args[0], images, imageCount))) {
+                        return false;
+                    }
+                    drawImage(image, args[1], args[2]);
+                    index += 3;
+                    break;
+                case CanvasCommand::DRAW_IMAGE_RECT:
+                    if (remaining < 5 || !(image = GetImage(args[0], images, imageCount))) {
+                        return false;
+                    }
+                    drawImage(image, args[1], args[2], args[3], args[4]);
+                    index += 5;
+                    break;
+                case CanvasCommand::DRAW_IMAGE_SUB_RECT:
+                    if (remaining < 9 || !(image = GetImage(args[0], images, imageCount))) {
+                        return false;
+                    }
+                    drawImage(image, args[1], args[2], args[3], args[4], args[5], args[6], args[7], args[8]);
+                    index += 9;
+                    break;
+                case CanvasCommand::SAVE:
+                    save();
+                    break;
+                case CanvasCommand::RESTORE:
+                    restore();
+                    break;
+                case CanvasCommand::TRANSLATE:
+                    if (remaining < 2) {
+                        return false;
+                    }
+                    translate(args[0], args[1]);
+                    index += 2;
+                    break;
+                case CanvasCommand::ROTATE:
+                    if (remaining < 1) {
+                        return false;
+                    }
+                    rotate(args[0]);
+                    index += 1;
+                    break;
+                case CanvasCommand::SCALE:
+                    if (remaining < 2) {
+                        return false;
+                    }
+                    scale(args[0], args[1]);
+                    index += 2;
+                    break;
+                case CanvasCommand::TRANSFORM:
+                    if (remaining < 6) {
+                        return false;
+                    }
+                    transform(args[0], args[1], args[2], args[3], args[4], args[5]);
+                    index += 6;
+                    break;
+                case CanvasCommand::SET_TRANSFORM:
+                    if (remaining < 6) {
+                        return false;
+                    }
+                    setTransform(args[0], args[1], args[2], args[3], args[4], args[5]);
+                    index += 6;
+                    break;
+                case CanvasCommand::RESET_TRANSFORM:
+                    resetTransform();
+                    break;
+                case CanvasCommand::SET_GLOBAL_ALPHA:
+                    if (remaining < 1) {
+                        return false;
+                    }
+                    setGlobalAlpha(args[0]);
+                    index += 1;
+                    break;
+                case CanvasCommand::SET_GLOBAL_COMPOSITE_OPERATION:
+                    if (remaining < 1 || !(args[0] >= 0 && args[0] < compositeOperationCount)) {
+                        return false;
+                    }
+                    state.globalCompositeOperation = compositeOperations[static_cast<size_t>(args[0])].mode;
+                    index += 1;
+                    break;
+                case CanvasCommand::SET_IMAGE_SMOOTHING_ENABLED:
+                    if (remaining < 1) {
+                        return false;
+                    }
+                    setImageSmoothingEnabled(args[0] != 0);
+                    index += 1;
+                    break;
+                case CanvasCommand::SET_FILL_COLOR:
+                    if (remaining < 2 || !ToColor(args[0], args[1], &state.fillColor)) {
+                        return false;
+                    }
+                    index += 2;
+                    break;
+                case CanvasCommand::SET_STROKE_COLOR:
+                    if (remaining < 2 || !ToColor(args[0], args[1], &state.strokeColor)) {
+                        return false;
+                    }
+                    index += 2;
+                    break;
+                case CanvasCommand::SET_LINE_WIDTH:
+                    if (remaining < 1) {
+                        return false;
+                    }
+                    setLineWidth(args[0]);
+                    index += 1;
+                    break;
+                case CanvasCommand::BEGIN_PATH:
+                    beginPath();
+                    break;
+                case CanvasCommand::CLOSE_PATH:
+                    closePath();
+                    break;
+                case CanvasCommand::MOVE_TO:
+                    if (remaining < 2) {
+                        return false;
+                    }
+                    moveTo(args[0], args[1]);
+                    index += 2;
+                    break;
+                case CanvasCommand::LINE_TO:
+                    if (remaining < 2) {
+                        return false;
+                    }
+                    lineTo(args[0], args[1]);
+                    index += 2;
+                    break;
+                case CanvasCommand::QUADRATIC_CURVE_TO:
+                    if (remaining < 4) {
+                        return false;
+                    }
+                    quadraticCurveTo(args[0], args[1], args[2], args[3]);
+                    index += 4;
+                    break;
+                case CanvasCommand::BEZIER_CURVE_TO:
+                    if (remaining < 6) {
+                        return false;
+                    }
+                    bezierCurveTo(args[0], args[1], args[2], args[3], args[4], args[5]);
+                    index += 6;
+                    break;
+                case CanvasCommand::ARC:
+                    if (remaining < 6 || !arc(args[0], args[1], args[2], args[3], args[4], args[5] != 0)) {
+                        return false;
+                    }
+                    index += 6;
+                    break;
+                case CanvasCommand::RECT:
+                    if (remaining < 4) {
+                        return false;
+                    }
+                    rect(args[0], args[1], args[2], args[3]);
+                    index += 4;
+                    break;
+                case CanvasCommand::FILL:
+                    if (remaining < 1) {
+                        return false;
+                    }
+                    fill(args[0] != 0 ? CanvasFillRule::EVENODD : CanvasFillRule::NONZERO);
+                    index += 1;
+                    break;
+                case CanvasCommand::STROKE:
+                    stroke();
+                    break;
+                case CanvasCommand::CLIP:
+                    if (remaining < 1) {
+                        return false;
+                    }
+                    clip(args[0] != 0 ? CanvasFillRule::EVENODD : CanvasFillRule::NONZERO);
+                    index += 1;
+                    break;
+                case CanvasCommand::SET_FONT:
+                    if (remaining < 1 || !(text = GetText(args[0], texts, textCount))) {
+                        return false;
+                    }
+                    setFont(*text);
+                    index += 1;
+                    break;
+                case CanvasCommand::SET_TEXT_ALIGN:
+                    if (remaining < 1 || !(args[0] >= 0 && args[0] < textAlignCount)) {
+                        return false;
+                    }
+                    state.textAlign = static_cast<CanvasTextAlign>(static_cast<size_t>(args[0]));
+                    index += 1;
+                    break;
+                case CanvasCommand::SET_TEXT_BASELINE:
+                    if (remaining < 1 || !(args[0] >= 0 && args[0] < textBaselineCount)) {
+                        return false;
+                    }
+                    state.textBaseline = static_cast<CanvasTextBaseline>(static_cast<size_t>(args[0]));
+                    index += 1;
+                    break;
+                case CanvasCommand::FILL_TEXT:
+                    if (remaining < 4 || !(text = GetText(args[0], texts, textCount))) {
+                        return false;
+                    }
+                    fillText(*text, args[1], args[2], args[3]);
+                    index += 4;
+                    break;
+                default:
+                    return false;
+            }
+        }
+        return true;
     }
 }
\ No newline at end of file
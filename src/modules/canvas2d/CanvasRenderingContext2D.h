@@ -27,18 +27,220 @@
 #ifndef CYDER_CANVASRENDERINGCONTEXT2D_H
 #define CYDER_CANVASRENDERINGCONTEXT2D_H
 
+#include <cmath>
+#include <string>
+#include <vector>
+#include "binding/ScriptWrappable.h"
 #include "modules/canvas/DrawingBuffer.h"
 #include "modules/canvas/RenderingContext.h"
 #include "modules/canvas/CanvasImageSource.h"
+#include "CanvasPath.h"
+#include "Path2D.h"
+#include "FontManager.h"
 
 namespace cyder {
 
-    class CanvasRenderingContext2D : public RenderingContext {
+    /**
+     * The alignment of text relative to the x coordinate passed to fillText(). The text direction is always
+     * left-to-right, so START is the same as LEFT, and END is the same as RIGHT.
+     */
+    enum class CanvasTextAlign {
+        START,
+        END,
+        LEFT,
+        RIGHT,
+        CENTER
+    };
+
+    /**
+     * The baseline of text relative to the y coordinate passed to fillText().
+     */
+    enum class CanvasTextBaseline {
+        TOP,
+        HANGING,
+        MIDDLE,
+        ALPHABETIC,
+        IDEOGRAPHIC,
+        BOTTOM
+    };
+
+    class CanvasRenderingContext2D : public ScriptWrappable, public RenderingContext, public CanvasPath {
+    DEFINE_WRAPPERTYPEINFO();
+
     public:
         explicit CanvasRenderingContext2D(DrawingBuffer* buffer);
 
         ~CanvasRenderingContext2D() override;
 
+        /**
+         * Alpha value that is applied to shapes and images before they are composited onto the canvas. Values outside of
+         * the range 0.0 to 1.0 are ignored.
+         */
+        float globalAlpha() const {
+            return state.globalAlpha;
+        }
+
+        void setGlobalAlpha(float value);
+
+        /**
+         * The type of compositing operation to apply when drawing new shapes, e.g. "source-over" or "multiply".
+         * Unknown values are ignored.
+         */
+        std::string globalCompositeOperation() const;
+
+        void setGlobalCompositeOperation(const std::string& value);
+
+        /**
+         * Image smoothing mode; if disabled, images will not be smoothed if scaled.
+         */
+        bool imageSmoothingEnabled() const {
+            return state.imageSmoothingEnabled;
+        }
+
+        void setImageSmoothingEnabled(bool value) {
+            state.imageSmoothingEnabled = value;
+        }
+
+        /**
+         * The color to use inside shapes, as a CSS color string. Unsupported colors are ignored.
+         */
+        std::string fillStyle() const;
+
+        void setFillStyle(const std::string& value);
+
+        /**
+         * The color to use for the lines around shapes, as a CSS color string. Unsupported colors are ignored.
+         */
+        std::string strokeStyle() const;
+
+        void setStrokeStyle(const std::string& value);
+
+        /**
+         * The thickness of lines in space units. Zero, negative, infinite and NaN values are ignored.
+         */
+        float lineWidth() const {
+            return state.lineWidth;
+        }
+
+        void setLineWidth(float value);
+
+        /**
+         * The current text style, as a CSS font string. Invalid fonts are ignored.
+         */
+        std::string font() const {
+            return state.font.text;
+        }
+
+        void setFont(const std::string& value);
+
+        /**
+         * The text alignment used when drawing text, e.g. "start" or "center". Unknown values are ignored.
+         */
+        std::string textAlign() const;
+
+        void setTextAlign(const std::string& value);
+
+        /**
+         * The text baseline used when drawing text, e.g. "alphabetic" or "middle". Unknown values are ignored.
+         */
+        std::string textBaseline() const;
+
+        void setTextBaseline(const std::string& value);
+
+        /**
+         * Saves the entire state of the canvas by pushing the current state onto a stack.
+         */
+        void save();
+
+        /**
+         * Restores the most recently saved canvas state by popping the top entry in the drawing state stack. If there is
+         * no saved state, this method does nothing.
+         */
+        void restore();
+
+        /**
+         * Adds a translation transformation by moving the canvas and its origin x horizontally and y vertically.
+         */
+        void translate(float x, float y);
+
+        /**
+         * Adds a rotation to the transformation matrix. The angle argument represents a clockwise rotation angle in
+         * radians.
+         */
+        void rotate(float angle);
+
+        /**
+         * Adds a scaling transformation to the canvas units by x horizontally and by y vertically.
+         */
+        void scale(float x, float y);
+
+        /**
+         * Multiplies the current transformation with the matrix described by the arguments:
+         * [a c e]
+         * [b d f]
+         * [0 0 1]
+         */
+        void transform(float a, float b, float c, float d, float e, float f);
+
+        /**
+         * Resets the current transform to the identity matrix, and then invokes transform() with the same arguments.
+         */
+        void setTransform(float a, float b, float c, float d, float e, float f);
+
+        /**
+         * Resets the current transform to the identity matrix.
+         */
+        void resetTransform();
+
+        /**
+         * Starts a new path by emptying the list of sub-paths.
+         */
+        void beginPath();
+
+        /**
+         * Fills the current path with the current fill style.
+         */
+        void fill(CanvasFillRule fillRule = CanvasFillRule::NONZERO);
+
+        /**
+         * Fills the specified path with the current fill style.
+         */
+        void fill(const Path2D* path, CanvasFillRule fillRule = CanvasFillRule::NONZERO);
+
+        /**
+         * Strokes the current path with the current stroke style.
+         */
+        void stroke();
+
+        /**
+         * Strokes the specified path with the current stroke style.
+         */
+        void stroke(const Path2D* path);
+
+        /**
+         * Turns the current path into the current clipping region. The clipping region is part of the drawing state.
+         */
+        void clip(CanvasFillRule fillRule = CanvasFillRule::NONZERO);
+
+        /**
+         * Turns the specified path into the current clipping region.
+         */
+        void clip(const Path2D* path, CanvasFillRule fillRule = CanvasFillRule::NONZERO);
+
+        /**
+         * Draws the text with the current font and fill style.
+         * @param text The text to draw.
+         * @param x The X coordinate of the point at which to begin drawing the text.
+         * @param y The Y coordinate of the point at which to begin drawing the text.
+         * @param maxWidth The maximum width of the text, it is condensed horizontally to fit in if it is wider.
+         */
+        void fillText(const std::string& text, float x, float y, float maxWidth = INFINITY);
+
+        /**
+         * Returns the width of the text drawn with the current font.
+         */
+        float measureText(const std::string& text);
+
         /**
          * Draws an image onto the canvas.
          * @param image An image to draw into the context.
@@ -76,8 +278,127 @@ namespace cyder {
         void drawImage(CanvasImageSource* image, float sourceX, float sourceY, float sourceWidth, float sourceHeight,
                        float targetX, float targetY, float targetWidth, float targetHeight);
 
+        /**
+         * Draws a batch of sprites from one image onto the canvas.
+         * @param image An image to draw into the context, typically a texture atlas.
+         * @param transforms Four values per sprite (scos, ssin, tx, ty) describing a rotation-scale transform that maps
+         * the top-left corner of the sub-rectangle to (tx, ty).
+         * @param srcRects Four values per sprite (x, y, width, height) describing the sub-rectangle of the image.
+         * @param colors Optional ARGB colors, one per sprite, which are multiplied with the sprite pixels. Pass nullptr
+         * to draw the sprites unmodified.
+         * @param count The number of sprites to draw.
+         */
+        void drawImageBatch(CanvasImageSource* image, const float* transforms, const float* srcRects,
+                            const SkColor* colors, int count);
+
+        /**
+         * Reads a rectangle of pixels from the buffer as unpremultiplied RGBA values. The pixels outside of the buffer
+         * are transparent black. If the buffer is rasterized by the CPU, the pixels are converted straight from the
+         * buffer memory.
+         * @param x The x coordinate of the upper left corner of the rectangle.
+         * @param y The y coordinate of the upper left corner of the rectangle.
+         * @param width The width of the rectangle, must be positive.
+         * @param height The height of the rectangle, must be positive.
+         * @param pixels The destination, it must hold width * height * 4 bytes.
+         * @returns false if the pixels could not be read.
+         */
+        bool getImageData(int x, int y, int width, int height, void* pixels);
+
+        /**
+         * Writes a rectangle of unpremultiplied RGBA pixels into the buffer. The drawing state (the transform, the
+         * clipping region, globalAlpha and globalCompositeOperation) does not apply.
+         * @param pixels The source pixels, width * height * 4 bytes.
+         * @param width The width of the source pixels.
+         * @param height The height of the source pixels.
+         * @param dx The x coordinate in the buffer at which to place the source pixels.
+         * @param dy The y coordinate in the buffer at which to place the source pixels.
+         * @param dirtyX The x coordinate of the upper left corner of the part of the source pixels to write.
+         * @param dirtyY The y coordinate of the upper left corner of the part of the source pixels to write.
+         * @param dirtyWidth The width of the part of the source pixels to write.
+         * @param dirtyHeight The height of the part of the source pixels to write.
+         */
+        void putImageData(const void* pixels, int width, int height, int dx, int dy,
+                          int dirtyX, int dirtyY, int dirtyWidth, int dirtyHeight);
+
+        /**
+         * Decodes and executes the commands encoded in a command buffer, see CanvasCommand for the format.
+         * @param commands The encoded commands.
+         * @param length The number of floats in commands.
+         * @param images The images referenced by the commands.
+         * @param imageCount The number of images.
+         * @param texts The strings referenced by the commands.
+         * @param textCount The number of strings.
+         * @returns false if the buffer is malformed, the commands before the malformed one have been executed.
+         */
+        bool executeCommands(const float* commands, size_t length, CanvasImageSource* const images[],
+                             size_t imageCount, const std::string texts[], size_t textCount);
+
     private:
+        struct State {
+            SkMatrix matrix = SkMatrix::I();
+            float globalAlpha = 1.0f;
+            SkBlendMode globalCompositeOperation = SkBlendMode::kSrcOver;
+            bool imageSmoothingEnabled = false;
+            SkColor fillColor = SK_ColorBLACK;
+            SkColor strokeColor = SK_ColorBLACK;
+            float lineWidth = 1.0f;
+            CanvasFont font;
+            CanvasTextAlign textAlign = CanvasTextAlign::START;
+            CanvasTextBaseline textBaseline = CanvasTextBaseline::ALPHABETIC;
+            /**
+             * The clipping paths in device space, they intersect with each other.
+             */
+            std::vector<SkPath> clipPaths;
+            /**
+             * Identifies the clipping paths, every call to clip() assigns a new one. 0 means no clip.
+             */
+            uint32_t clipID = 0;
+        };
+
         DrawingBuffer* buffer;
+        State state;
+        std::vector<State> stateStack;
+        std::vector<SkRect> batchRects;
+        uint32_t lastClipID = 0;
+        /**
+         * The canvas and the clip that were applied to it by the last draw.
+         */
+        SkCanvas* clippedCanvas = nullptr;
+        uint32_t appliedClipID = 0;
+
+        /**
+         * Returns the canvas of the buffer with the current clip and the specified transform applied. The transform is
+         * set on each draw, but the clip is only applied again when it or the canvas has changed since the last draw,
+         * e.g. when the buffer resizes or starts a new recording, since rebuilding an anti-aliased clip is costly.
+         * @param bounds The bounds of the drawing, in the coordinates of the transform. The buffer is told that only
+         * the pixels in these bounds change.
+         * @param matrix The transform to apply, or nullptr to apply the current transform.
+         */
+        SkCanvas* getCanvas(const SkRect& bounds, const SkMatrix* matrix = nullptr);
+
+        /**
+         * Returns the paint to draw shapes with.
+         */
+        SkPaint makeShapePaint(SkColor color, SkPaint::Style style) const;
+
+        void fillPath(const SkPath& path, const SkMatrix* matrix, CanvasFillRule fillRule);
+
+        void strokePath(const SkPath& path, const SkMatrix* matrix);
+
+        void clipPath(SkPath path, CanvasFillRule fillRule);
+
+    protected:
+        /**
+         * The points of the current path are transformed by the current transform when they are added.
+         */
+        const SkMatrix* pathTransform() const override {
+            return state.matrix.isIdentity() ? nullptr : &state.matrix;
+        }
+
+        /**
+         * Returns the paint to draw images with, or nullptr if the default paint applies.
+         */
+        const SkPaint* getImagePaint(SkPaint* paint) const;
     };
 
 }
@@ -0,0 +1,260 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017-present, cyder.org
+//  All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in the
+//  Software without restriction, including without limitation the rights to use, copy,
+//  modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//  and to permit persons to whom the Software is furnished to do so, subject to the
+//  following conditions:
+//
+//      The above copyright notice and this permission notice shall be included in all
+//      copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED *AS IS*, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//  PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "FontManager.h"
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+namespace cyder {
+
+    /**
+     * The maximum number of text runs kept in the cache.
+     */
+    static const size_t MAX_TEXT_RUN_COUNT = 1024;
+    /**
+     * The maximum number of parsed font strings kept in the cache, it is cleared when full. Scripts rarely use more
+     * than a few fonts, but some of them build font strings with animated sizes.
+     */
+    static const size_t MAX_FONT_COUNT = 256;
+    /**
+     * The font size that the relative units (em, rem and %) are relative to, which is the size of the default font.
+     */
+    static const float DEFAULT_FONT_SIZE = 10.0f;
+
+    FontManager* FontManager::GetInstance() {
+        static FontManager* instance = new FontManager();
+        return instance;
+    }
+
+    FontManager::FontManager() : fontMgr(SkFontMgr::RefDefault()) {
+    }
+
+    static std::string Trim(const std::string& text) {
+        auto start = text.find_first_not_of(" \t\n\r\f");
+        if (start == std::string::npos) {
+            return "";
+        }
+        auto end = text.find_last_not_of(" \t\n\r\f");
+        return text.substr(start, end - start + 1);
+    }
+
+    static bool ParseFontSize(const std::string& token, float* size) {
+        // Drop the line-height part, e.g. "12px/1.5".
+        auto value = token.substr(0, token.find('/'));
+        char* end = nullptr;
+        float number = strtof(value.c_str(), &end);
+        if (end == value.c_str() || !(number >= 0)) {
+            return false;
+        }
+        std::string unit(end);
+        if (unit == "px") {
+            *size = number;
+        } else if (unit == "pt") {
+            *size = number * 4 / 3;
+        } else if (unit == "em" || unit == "rem") {
+            *size = number * DEFAULT_FONT_SIZE;
+        } else if (unit == "%") {
+            *size = number * DEFAULT_FONT_SIZE / 100;
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    static bool ParseFontWeight(const std::string& token, int* weight) {
+        if (token == "bold" || token == "bolder") {
+            *weight = SkFontStyle::kBold_Weight;
+            return true;
+        }
+        if (token == "lighter") {
+            *weight = SkFontStyle::kLight_Weight;
+            return true;
+        }
+        if (token.size() == 3 && token[0] >= '1' && token[0] <= '9' && token.compare(1, 2, "00") == 0) {
+            *weight = (token[0] - '0') * 100;
+            return true;
+        }
+        return false;
+    }
+
+    bool FontManager::parseFont(const std::string& text, CanvasFont* font) {
+        auto cached = fonts.find(text);
+        if (cached != fonts.end()) {
+            *font = cached->second;
+            return true;
+        }
+        auto slant = SkFontStyle::kUpright_Slant;
+        int weight = SkFontStyle::kNormal_Weight;
+        float size = 0;
+        bool hasSize = false;
+        size_t position = 0;
+        // Read the tokens before the font-family value, the last of them must be the font-size value.
+        while (!hasSize) {
+            auto start = text.find_first_not_of(" \t\n\r\f", position);
+            if (start == std::string::npos) {
+                return false;
+            }
+            position = text.find_first_of(" \t\n\r\f", start);
+            if (position == std::string::npos) {
+                return false;
+            }
+            auto token = text.substr(start, position - start);
+            if (token == "normal" || token == "small-caps") {
+                continue;
+            }
+            if (token == "italic" || token == "oblique") {
+                slant = token == "italic" ? SkFontStyle::kItalic_Slant : SkFontStyle::kOblique_Slant;
+                continue;
+            }
+            if (ParseFontWeight(token, &weight)) {
+                continue;
+            }
+            if (!ParseFontSize(token, &size)) {
+                return false;
+            }
+            hasSize = true;
+        }
+        auto families = Trim(text.substr(position));
+        if (families.empty()) {
+            return false;
+        }
+        SkFontStyle style(weight, SkFontStyle::kNormal_Width, slant);
+        CanvasFont result;
+        result.typeface = matchTypeface(families, style);
+        result.size = size;
+        SkPaint paint;
+        paint.setTypeface(result.typeface);
+        paint.setTextSize(size);
+        SkPaint::FontMetrics metrics;
+        paint.getFontMetrics(&metrics);
+        result.ascent = -metrics.fAscent;
+        result.descent = metrics.fDescent;
+        std::ostringstream stream;
+        if (slant != SkFontStyle::kUpright_Slant) {
+            stream << (slant == SkFontStyle::kItalic_Slant ? "italic " : "oblique ");
+        }
+        if (weight == SkFontStyle::kBold_Weight) {
+            stream << "bold ";
+        } else if (weight != SkFontStyle::kNormal_Weight) {
+            stream << weight << " ";
+        }
+        stream << size << "px " << families;
+        result.text = stream.str();
+        if (fonts.size() >= MAX_FONT_COUNT) {
+            fonts.clear();
+        }
+        fonts[text] = result;
+        *font = result;
+        return true;
+    }
+
+    sk_sp<SkTypeface> FontManager::matchTypeface(const std::string& families, const SkFontStyle& style) {
+        std::ostringstream stream;
+        stream << style.weight() << ":" << style.slant() << ":" << families;
+        auto key = stream.str();
+        auto cached = typefaces.find(key);
+        if (cached != typefaces.end()) {
+            return cached->second;
+        }
+        sk_sp<SkTypeface> typeface;
+        std::istringstream list(families);
+        std::string family;
+        // Use the first family in the list that is available.
+        while (!typeface && std::getline(list, family, ',')) {
+            family = Trim(family);
+            if (family.size() >= 2 && (family[0] == '"' || family[0] == '\'') && family.back() == family[0]) {
+                family = family.substr(1, family.size() - 2);
+            }
+            if (family.empty() || family == "sans-serif") {
+                continue;
+            }
+            typeface.reset(fontMgr->matchFamilyStyle(family.c_str(), style));
+        }
+        if (!typeface) {
+            typeface.reset(fontMgr->matchFamilyStyle(nullptr, style));
+        }
+        if (!typeface) {
+            typeface = SkTypeface::MakeDefault();
+        }
+        typefaces[key] = typeface;
+        return typeface;
+    }
+
+    TextRun FontManager::getTextRun(const CanvasFont& font, const std::string& text) {
+        std::string key;
+        key.reserve(sizeof(uint32_t) + sizeof(float) + text.size());
+        auto typefaceID = font.typeface->uniqueID();
+        key.append(reinterpret_cast<const char*>(&typefaceID), sizeof(typefaceID));
+        key.append(reinterpret_cast<const char*>(&font.size), sizeof(font.size));
+        key.append(text);
+        auto cached = textRunMap.find(key);
+        if (cached != textRunMap.end()) {
+            // Move the run to the front, the least recently used runs are at the back.
+            textRuns.splice(textRuns.begin(), textRuns, cached->second);
+            return cached->second->second;
+        }
+        auto run = makeTextRun(font, text);
+        textRuns.emplace_front(key, run);
+        textRunMap[key] = textRuns.begin();
+        if (textRuns.size() > MAX_TEXT_RUN_COUNT) {
+            textRunMap.erase(textRuns.back().first);
+            textRuns.pop_back();
+        }
+        return run;
+    }
+
+    TextRun FontManager::makeTextRun(const CanvasFont& font, const std::string& text) {
+        TextRun run;
+        SkPaint paint;
+        paint.setTypeface(font.typeface);
+        paint.setTextSize(font.size);
+        paint.setAntiAlias(true);
+        paint.setSubpixelText(true);
+        paint.setTextEncoding(SkPaint::kUTF8_TextEncoding);
+        auto glyphCount = paint.countText(text.data(), text.size());
+        if (glyphCount <= 0) {
+            return run;
+        }
+        glyphBuffer.resize(static_cast<size_t>(glyphCount));
+        widthBuffer.resize(static_cast<size_t>(glyphCount));
+        paint.textToGlyphs(text.data(), text.size(), glyphBuffer.data());
+        paint.setTextEncoding(SkPaint::kGlyphID_TextEncoding);
+        paint.getTextWidths(glyphBuffer.data(), glyphCount * sizeof(SkGlyphID), widthBuffer.data());
+        SkTextBlobBuilder builder;
+        auto& buffer = builder.allocRunPosH(paint, glyphCount, 0);
+        memcpy(buffer.glyphs, glyphBuffer.data(), glyphCount * sizeof(SkGlyphID));
+        float x = 0;
+        for (int i = 0; i < glyphCount; i++) {
+            buffer.pos[i] = x;
+            x += widthBuffer[i];
+        }
+        run.blob = builder.make();
+        run.width = x;
+        return run;
+    }
+}
@@ -0,0 +1,115 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017-present, cyder.org
+//  All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in the
+//  Software without restriction, including without limitation the rights to use, copy,
+//  modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//  and to permit persons to whom the Software is furnished to do so, subject to the
+//  following conditions:
+//
+//      The above copyright notice and this permission notice shall be included in all
+//      copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED *AS IS*, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//  PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef CYDER_FONTMANAGER_H
+#define CYDER_FONTMANAGER_H
+
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <skia.h>
+
+namespace cyder {
+
+    /**
+     * A font resolved from a CSS font string.
+     */
+    struct CanvasFont {
+        sk_sp<SkTypeface> typeface;
+        float size = 0;
+        /**
+         * The distance from the alphabetic baseline to the top of the font, positive upwards.
+         */
+        float ascent = 0;
+        /**
+         * The distance from the alphabetic baseline to the bottom of the font, positive downwards.
+         */
+        float descent = 0;
+        /**
+         * The font serialized as a CSS font string.
+         */
+        std::string text;
+    };
+
+    /**
+     * A run of text converted to glyphs and positioned, with its origin at the left end of the alphabetic baseline.
+     */
+    struct TextRun {
+        /**
+         * The positioned glyphs, nullptr if the text has no glyphs.
+         */
+        sk_sp<SkTextBlob> blob;
+        float width = 0;
+    };
+
+    /**
+     * FontManager resolves CSS font strings to typefaces and caches the text runs built from them. Most of the text
+     * drawn by an application is repeated every frame, e.g. the labels of a HUD, so the runs are kept in a LRU cache
+     * keyed by (typeface, size, text) and reused instead of converting the text to glyphs on each draw. The
+     * FontManager is only accessed from the main thread.
+     */
+    class FontManager {
+    public:
+        /**
+         * Returns the font manager shared by all the rendering contexts.
+         */
+        static FontManager* GetInstance();
+
+        /**
+         * Parses a CSS font shorthand string, e.g. "bold 12px Arial, sans-serif". The font-style, font-variant and
+         * font-weight values are optional, the font-size and font-family values are required.
+         * @param text The CSS font string to parse.
+         * @param font On success, receives the parsed font.
+         * @returns false if the text is not a valid font.
+         */
+        bool parseFont(const std::string& text, CanvasFont* font);
+
+        /**
+         * Returns the text run of the text drawn in the specified font.
+         */
+        TextRun getTextRun(const CanvasFont& font, const std::string& text);
+
+    private:
+        FontManager();
+
+        sk_sp<SkTypeface> matchTypeface(const std::string& families, const SkFontStyle& style);
+
+        TextRun makeTextRun(const CanvasFont& font, const std::string& text);
+
+        sk_sp<SkFontMgr> fontMgr;
+        std::unordered_map<std::string, sk_sp<SkTypeface>> typefaces;
+        std::unordered_map<std::string, CanvasFont> fonts;
+        std::list<std::pair<std::string, TextRun>> textRuns;
+        std::unordered_map<std::string, std::list<std::pair<std::string, TextRun>>::iterator> textRunMap;
+        std::vector<SkGlyphID> glyphBuffer;
+        std::vector<SkScalar> widthBuffer;
+    };
+
+}
+
+#endif //CYDER_FONTMANAGER_H
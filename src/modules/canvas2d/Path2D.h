@@ -0,0 +1,71 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017-present, cyder.org
+//  All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in the
+//  Software without restriction, including without limitation the rights to use, copy,
+//  modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//  and to permit persons to whom the Software is furnished to do so, subject to the
+//  following conditions:
+//
+//      The above copyright notice and this permission notice shall be included in all
+//      copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED *AS IS*, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//  PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CYDER_PATH2D_H
+#define CYDER_PATH2D_H
+
+#include "binding/ScriptWrappable.h"
+#include "CanvasPath.h"
+
+namespace cyder {
+
+    /**
+     * The Path2D class is used to declare paths that are then later used on CanvasRenderingContext2D objects. A path
+     * that is built once and drawn many times keeps a stable generation ID, which allows Skia to reuse the cached
+     * tessellation and masks of the path.
+     */
+    class Path2D : public ScriptWrappable, public CanvasPath {
+    DEFINE_WRAPPERTYPEINFO();
+
+    public:
+        Path2D() {
+        }
+
+        /**
+         * Creates a copy of the specified path.
+         */
+        explicit Path2D(const SkPath& path) {
+            _path = path;
+        }
+
+        /**
+         * Adds a path to the current path.
+         * @param path A Path2D path to add.
+         * @param transform A matrix to be used as the transformation matrix for the path that is added, or nullptr to
+         * add the path as it is.
+         */
+        void addPath(const Path2D* path, const SkMatrix* transform = nullptr) {
+            if (transform) {
+                _path.addPath(path->_path, *transform);
+            } else {
+                _path.addPath(path->_path);
+            }
+        }
+    };
+
+}
+
+#endif //CYDER_PATH2D_H
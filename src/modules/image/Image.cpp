@@ -25,13 +25,112 @@
 //////////////////////////////////////////////////////////////////////////////////////
 
 #include "Image.h"
+#include "utils/PixelConverter.h"
+#include <algorithm>
+#include <memory>
 
 namespace cyder {
     Image* Image::Decode(const void* bytes, size_t length) {
         if (!length) {
             return nullptr;
         }
-        auto codec = SkCodec::NewFromData(SkData::MakeWithoutCopy(bytes, length));
+        return Decode(SkData::MakeWithoutCopy(bytes, length));
+    }
+
+    Image* Image::Decode(sk_sp<SkData> data, const ImageDecodeOptions& options) {
+        auto image = DecodeImage(std::move(data), options).release();
+        if (!image) {
+            return nullptr;
+        }
+        return new Image(image);
+    }
+
+    /**
+     * Returns the smallest sample size that fits the image decoded by the codec in the maximum size.
+     */
+    static int ComputeSampleSize(SkAndroidCodec* codec, int maxWidth, int maxHeight) {
+        auto info = codec->getInfo();
+        float scale = 1.0f;
+        if (maxWidth > 0) {
+            scale = std::min(scale, static_cast<float>(maxWidth) / info.width());
+        }
+        if (maxHeight > 0) {
+            scale = std::min(scale, static_cast<float>(maxHeight) / info.height());
+        }
+        if (scale >= 1.0f) {
+            return 1;
+        }
+        // Some codecs round the sampled size up, start from the estimate and increase it until the image fits.
+        int sampleSize = std::max(1, static_cast<int>(1.0f / scale));
+        int maxSampleSize = std::max(info.width(), info.height());
+        while (sampleSize < maxSampleSize) {
+            auto size = codec->getSampledDimensions(sampleSize);
+            if ((maxWidth <= 0 || size.width() <= maxWidth) && (maxHeight <= 0 || size.height() <= maxHeight)) {
+                break;
+            }
+            sampleSize++;
+        }
+        return sampleSize;
+    }
+
+    /**
+     * Decodes the image downsampled by the sample size.
+     */
+    static sk_sp<SkImage> DecodeSampled(SkAndroidCodec* codec, int sampleSize) {
+        // JPEG and WEBP scale while decoding, the other formats skip the rows and columns not sampled.
+        auto size = codec->getSampledDimensions(sampleSize);
+        SkBitmap bitmap;
+        bitmap.allocN32Pixels(size.width(), size.height(), codec->getInfo().isOpaque());
+        SkAndroidCodec::AndroidOptions options;
+        options.fSampleSize = sampleSize;
+        auto result = codec->getAndroidPixels(bitmap.info(), bitmap.getPixels(), bitmap.rowBytes(), &options);
+        if (result != SkCodec::kSuccess) {
+            return nullptr;
+        }
+        bitmap.setImmutable();
+        bitmap.lockPixels();
+        return SkImage::MakeFromBitmap(bitmap);
+    }
+
+    sk_sp<SkImage> Image::DecodeImage(sk_sp<SkData> data, const ImageDecodeOptions& options) {
+        if (!data || !data->size()) {
+            return nullptr;
+        }
+        if (options.lazy) {
+            // Only the header is parsed here, the pixels are decoded into the resource cache when the image is drawn.
+            if (options.maxWidth <= 0 && options.maxHeight <= 0) {
+                return SkImage::MakeFromEncoded(std::move(data));
+            }
+            std::unique_ptr<SkAndroidCodec> codec(SkAndroidCodec::NewFromData(data));
+            if (!codec) {
+                return nullptr;
+            }
+            int sampleSize = ComputeSampleSize(codec.get(), options.maxWidth, options.maxHeight);
+            if (sampleSize == 1) {
+                return SkImage::MakeFromEncoded(std::move(data));
+            }
+            return DecodeSampled(codec.get(), sampleSize);
+        }
+        return DecodeImage(new SkMemoryStream(std::move(data)), options);
+    }
+
+    sk_sp<SkImage> Image::DecodeImage(SkStream* stream, const ImageDecodeOptions& options) {
+        if (options.lazy) {
+            // A lazy image keeps its encoded data, read the stream into memory.
+            std::unique_ptr<SkStream> owner(stream);
+            if (!stream->hasLength()) {
+                return nullptr;
+            }
+            return DecodeImage(SkData::MakeFromStream(stream, stream->getLength()), options);
+        }
+        if (options.maxWidth > 0 || options.maxHeight > 0) {
+            std::unique_ptr<SkAndroidCodec> codec(SkAndroidCodec::NewFromStream(stream));
+            if (!codec) {
+                return nullptr;
+            }
+            return DecodeSampled(codec.get(), ComputeSampleSize(codec.get(), options.maxWidth, options.maxHeight));
+        }
+        auto codec = SkCodec::NewFromStream(stream);
         if (!codec) {
             return nullptr;
         }
@@ -46,21 +145,50 @@ namespace cyder {
         }
         bitmap.setImmutable();
         bitmap.lockPixels();
-        auto image = SkImage::MakeFromBitmap(bitmap).release();
-        return new Image(image);
+        return SkImage::MakeFromBitmap(bitmap);
+    }
+
+    size_t Image::DecodedImageBudget() {
+        return SkGraphics::GetResourceCacheTotalByteLimit();
+    }
+
+    void Image::SetDecodedImageBudget(size_t bytes) {
+        // Shrinking the limit purges the least recently used entries immediately.
+        SkGraphics::SetResourceCacheTotalByteLimit(bytes);
+    }
+
+    /**
+     * Wraps the pixels into an image without copying them. Transparent pixels must be premultiplied in the native 32-bit
+     * format, opaque pixels look the same premultiplied or not, so they are drawn in their RGBA order as they are.
+     */
+    static Image* MakeRasterImage(sk_sp<SkData> pixels, int width, int height, bool transparent) {
+        auto info = transparent ? SkImageInfo::MakeN32Premul(width, height) :
+                    SkImageInfo::Make(width, height, kRGBA_8888_SkColorType, kOpaque_SkAlphaType);
+        auto image = SkImage::MakeRasterData(info, std::move(pixels), info.minRowBytes());
+        return image ? new Image(image.release()) : nullptr;
     }
 
     Image* Image::MakeFromPixels(const void* pixels, int width, int height, bool transparent) {
-        const size_t bytesPerRow = static_cast<size_t>(4 * width);
-        SkBitmap bitmap;
-        bitmap.allocN32Pixels(width, height, !transparent);
-        SkCanvas canvas(bitmap);
-        SkImageInfo info = SkImageInfo::Make(width, height, kRGBA_8888_SkColorType, kUnpremul_SkAlphaType);
-        if (!canvas.writePixels(info, pixels, bytesPerRow, 0, 0)) {
+        const size_t byteLength = static_cast<size_t>(4 * width) * height;
+        if (!transparent) {
+            return MakeRasterImage(SkData::MakeWithCopy(pixels, byteLength), width, height, false);
+        }
+        // Premultiplying while copying touches the pixels only once.
+        auto data = SkData::MakeUninitialized(byteLength);
+        PixelConverter::Premultiply(static_cast<const uint32_t*>(pixels), static_cast<uint32_t*>(data->writable_data()),
+                                    width * height, kN32_SkColorType == kBGRA_8888_SkColorType);
+        return MakeRasterImage(std::move(data), width, height, true);
+    }
+
+    Image* Image::MakeFromPixels(sk_sp<SkData> pixels, int width, int height, bool transparent) {
+        if (!pixels || pixels->size() < static_cast<size_t>(4 * width) * height) {
             return nullptr;
         }
-        auto image = SkImage::MakeFromBitmap(bitmap).release();
-        return new Image(image);
+        if (transparent) {
+            auto data = static_cast<uint32_t*>(pixels->writable_data());
+            PixelConverter::Premultiply(data, data, width * height, kN32_SkColorType == kBGRA_8888_SkColorType);
+        }
+        return MakeRasterImage(std::move(pixels), width, height, transparent);
     }
 
     Image::Image(SkImage* pixels) :
@@ -87,10 +215,9 @@ namespace cyder {
         }
         if (sharePixels) {
             pixels->ref();
-            if (!subset && bounds == rect) {
-                return new Image(pixels);
-            }
-            return new Image(pixels, rect);
+            auto image = !subset && bounds == rect ? new Image(pixels) : new Image(pixels, rect);
+            image->pixelsCached = pixelsCached;
+            return image;
         } else {
             auto subImage = pixels->makeSubset(rect).release();
             if (!subImage) {
@@ -139,7 +266,13 @@ namespace cyder {
         return pixels->readPixels(info, buffer, static_cast<size_t>(4 * width), rect.x(), rect.y());
     }
 
-    void Image::draw(SkCanvas* canvas, const SkRect& dstRect, const SkRect& srcRect) {
+    void Image::setPixels(sk_sp<SkImage> newPixels) {
+        SkSafeUnref(pixels);
+        pixels = newPixels.release();
+        pixelsCached = false;
+    }
+
+    void Image::draw(SkCanvas* canvas, const SkRect& dstRect, const SkRect& srcRect, const SkPaint* paint) {
         SkRect adjustedSrcRect = srcRect;
         if(subset){
             adjustedSrcRect.offset(subset->fLeft,subset->fTop);
@@ -150,6 +283,22 @@ namespace cyder {
         if (adjustedSrcRect.isEmpty() || dstRect.isEmpty()){
             return;  // Nothing to draw.
         }
-        canvas->drawImageRect(pixels, adjustedSrcRect, dstRect, nullptr);
+        canvas->drawImageRect(pixels, adjustedSrcRect, dstRect, paint);
+    }
+
+    void Image::drawAtlas(SkCanvas* canvas, const SkRSXform transforms[], SkRect srcRects[],
+                          const SkColor colors[], int count, const SkPaint* paint) {
+        if (count <= 0) {
+            return;
+        }
+        if (!subset) {
+            canvas->drawAtlas(pixels, transforms, srcRects, colors, count, SkBlendMode::kModulate, nullptr, paint);
+            return;
+        }
+        // The source rects are relative to the subset, move them into the coordinate space of the shared pixels.
+        for (int i = 0; i < count; i++) {
+            srcRects[i].offset(subset->fLeft, subset->fTop);
+        }
+        canvas->drawAtlas(pixels, transforms, srcRects, colors, count, SkBlendMode::kModulate, nullptr, paint);
     }
 }
\ No newline at end of file
@@ -29,17 +29,78 @@
 
 #include <skia.h>
 #include "ImageFormat.h"
+#include "binding/ScriptWrappable.h"
 #include "modules/canvas/CanvasImageSource.h"
 
 namespace cyder {
 
+    struct ImageDecodeOptions {
+        /**
+         * If true, the image keeps the encoded data and decodes it on demand the first time it is drawn. The decoded
+         * pixels are then held under the decoded image budget and may be discarded at any time, the least recently
+         * drawn images are evicted first.
+         */
+        bool lazy = false;
+        /**
+         * The maximum width of the decoded image, 0 means unlimited. An image larger than the maximum size is
+         * downsampled while decoding, by the smallest integer factor that fits it in.
+         */
+        int maxWidth = 0;
+        /**
+         * The maximum height of the decoded image, 0 means unlimited.
+         */
+        int maxHeight = 0;
+    };
+
     /**
      * A wrapper for SkImage.
      */
-    class Image : public CanvasImageSource {
+    class Image : public ScriptWrappable, public CanvasImageSource {
+    DEFINE_WRAPPERTYPEINFO();
+
     public:
         static Image* Decode(const void* bytes, size_t length);
+        /**
+         * Decodes the encoded bytes held by the data, which may be memory-mapped, without copying them. A downsampled
+         * image is always decoded immediately, the lazy option is ignored for it.
+         */
+        static Image* Decode(sk_sp<SkData> data, const ImageDecodeOptions& options = ImageDecodeOptions());
+
+        /**
+         * Decodes the encoded bytes held by the data in the same way as Decode(), but returns the SkImage itself so
+         * that it can be shared by multiple Image objects.
+         */
+        static sk_sp<SkImage> DecodeImage(sk_sp<SkData> data,
+                                          const ImageDecodeOptions& options = ImageDecodeOptions());
+
+        /**
+         * Decodes the encoded bytes read from the stream, which is deleted when the decoding is done. Unless the image
+         * is lazy, the bytes are consumed as the codec reads them and are never held in memory as a whole.
+         */
+        static sk_sp<SkImage> DecodeImage(SkStream* stream, const ImageDecodeOptions& options = ImageDecodeOptions());
+
+        /**
+         * Returns the maximum number of bytes of decoded pixels held for lazily decoded images.
+         */
+        static size_t DecodedImageBudget();
+
+        /**
+         * Sets the maximum number of bytes of decoded pixels held for lazily decoded images. Note that the budget is
+         * shared with other pixel caches of skia, such as the scaled copies of images.
+         */
+        static void SetDecodedImageBudget(size_t bytes);
+
+        /**
+         * Creates an image with a copy of the unpremultiplied RGBA pixels.
+         */
         static Image* MakeFromPixels(const void* pixels, int width, int height, bool transparent = true);
+
+        /**
+         * Creates an image that takes over the unpremultiplied RGBA pixels without copying them. If the image is
+         * transparent, the pixels are premultiplied in place, so the data must not be shared with anything else.
+         */
+        static Image* MakeFromPixels(sk_sp<SkData> pixels, int width, int height, bool transparent = true);
+
         explicit Image(SkImage* pixels);
         ~Image();
 
@@ -61,7 +122,23 @@ namespace cyder {
             return !pixels->isOpaque();
         }
 
-        void draw(SkCanvas* canvas, const SkRect& dstRect, const SkRect& srcRect) override;
+        /**
+         * Returns the number of bytes of decoded pixels kept alive by the image. Lazily decoded images return zero,
+         * their pixels are held by the budgeted cache of skia instead, and so do the images sharing the pixels of the
+         * image cache, which reports them once for all of its images. A subset that shares the pixels of another image
+         * only counts the size of its own area.
+         */
+        size_t memoryUsage() const override {
+            if (pixelsCached || pixels->isLazyGenerated()) {
+                return 0;
+            }
+            return static_cast<size_t>(width()) * height() * 4;
+        }
+
+        void draw(SkCanvas* canvas, const SkRect& dstRect, const SkRect& srcRect, const SkPaint* paint) override;
+
+        void drawAtlas(SkCanvas* canvas, const SkRSXform transforms[], SkRect srcRects[],
+                       const SkColor colors[], int count, const SkPaint* paint) override;
 
         /**
          * Encode the image's pixels and return the result as a new SkData, which the caller must manage (i.e. call
@@ -92,9 +169,32 @@ namespace cyder {
          */
         bool readPixels(void* buffer, int x, int y, int width, int height);
 
+        /**
+         * Replaces the pixels of the image with new ones of the same size, e.g. to show more rows of an image that is
+         * decoded progressively. Only the image itself is affected, the subsets made from it keep referencing the old
+         * pixels.
+         */
+        void setPixels(sk_sp<SkImage> newPixels);
+
+        /**
+         * Returns true if the pixels are also referenced by something else than this image, e.g. a subset sharing
+         * them, an encoding snapshot or a recorded picture.
+         */
+        bool sharesPixels() const {
+            return !pixels->unique();
+        }
+
+        /**
+         * Marks the pixels as held by the image cache, which then accounts for their memory instead of this image.
+         */
+        void setPixelsCached(bool value) {
+            pixelsCached = value;
+        }
+
     private:
         SkImage* pixels;
         SkIRect* subset;
+        bool pixelsCached = false;
 
         Image(SkImage* image, const SkIRect& subset);
     };
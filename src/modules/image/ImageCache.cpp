@@ -0,0 +1,172 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017-present, cyder.org
+//  All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in the
+//  Software without restriction, including without limitation the rights to use, copy,
+//  modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//  and to permit persons to whom the Software is furnished to do so, subject to the
+//  following conditions:
+//
+//      The above copyright notice and this permission notice shall be included in all
+//      copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED *AS IS*, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//  PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "ImageCache.h"
+#include <algorithm>
+#include <sstream>
+#include "utils/HashUtil.h"
+
+namespace cyder {
+
+    /**
+     * The default budget of the cache, enough for a few dozens of large atlases.
+     */
+    static const size_t DEFAULT_BYTE_LIMIT = 64 * 1024 * 1024;
+
+    ImageCache* ImageCache::GetInstance() {
+        static ImageCache* instance = new ImageCache();
+        return instance;
+    }
+
+    /**
+     * Writes the decode options to the key, the same content decoded with different options is cached separately.
+     */
+    static void WriteOptions(std::stringstream& key, const ImageDecodeOptions& options) {
+        key << (options.lazy ? "lazy:" : "eager:") << options.maxWidth << "x" << options.maxHeight << ":";
+    }
+
+    std::string ImageCache::FileKey(const std::string& path, int64_t modifiedTime, size_t size,
+                                    const ImageDecodeOptions& options) {
+        std::stringstream key;
+        key << "file:";
+        WriteOptions(key, options);
+        key << modifiedTime << ":" << size << ":" << path;
+        return key.str();
+    }
+
+    std::string ImageCache::DataKey(const void* bytes, size_t length, const ImageDecodeOptions& options) {
+        std::stringstream key;
+        key << "data:";
+        WriteOptions(key, options);
+        key << std::hex << HashUtil::Hash64(bytes, length) << ":" << length;
+        return key.str();
+    }
+
+    ImageCache::ImageCache() : byteLimit(DEFAULT_BYTE_LIMIT) {
+    }
+
+    sk_sp<SkImage> ImageCache::find(const std::string& key) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto cached = entryMap.find(key);
+        if (cached == entryMap.end()) {
+            misses++;
+            return nullptr;
+        }
+        hits++;
+        // Move the entry to the front, the least recently used entries are at the back.
+        entries.splice(entries.begin(), entries, cached->second);
+        return cached->second->image;
+    }
+
+    sk_sp<SkImage> ImageCache::findAlias(const std::string& alias) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto key = aliasMap.find(alias);
+        if (key == aliasMap.end()) {
+            return nullptr;
+        }
+        // The aliases are removed along with their entry, the entry is always there.
+        auto cached = entryMap.find(key->second);
+        hits++;
+        entries.splice(entries.begin(), entries, cached->second);
+        return cached->second->image;
+    }
+
+    void ImageCache::addAlias(const std::string& alias, const std::string& key) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto cached = entryMap.find(key);
+        if (cached == entryMap.end()) {
+            return;
+        }
+        auto oldKey = aliasMap.find(alias);
+        if (oldKey != aliasMap.end()) {
+            if (oldKey->second == key) {
+                return;
+            }
+            auto& aliases = entryMap.find(oldKey->second)->second->aliases;
+            aliases.erase(std::find(aliases.begin(), aliases.end(), alias));
+        }
+        aliasMap[alias] = key;
+        cached->second->aliases.push_back(alias);
+    }
+
+    sk_sp<SkImage> ImageCache::add(const std::string& key, sk_sp<SkImage> image, size_t bytes, bool* cached) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (cached) {
+            *cached = true;
+        }
+        auto entry = entryMap.find(key);
+        if (entry != entryMap.end()) {
+            entries.splice(entries.begin(), entries, entry->second);
+            return entry->second->image;
+        }
+        if (bytes > byteLimit) {
+            if (cached) {
+                *cached = false;
+            }
+            return image;
+        }
+        entries.push_front({key, image, bytes, {}});
+        entryMap[key] = entries.begin();
+        totalBytes += bytes;
+        purge();
+        return image;
+    }
+
+    size_t ImageCache::budget() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return byteLimit;
+    }
+
+    void ImageCache::setBudget(size_t bytes) {
+        std::lock_guard<std::mutex> lock(mutex);
+        byteLimit = bytes;
+        purge();
+    }
+
+    ImageCacheStats ImageCache::stats() {
+        std::lock_guard<std::mutex> lock(mutex);
+        ImageCacheStats result;
+        result.hits = hits;
+        result.misses = misses;
+        result.count = entries.size();
+        result.bytes = totalBytes;
+        return result;
+    }
+
+    void ImageCache::purge() {
+        while (totalBytes > byteLimit) {
+            auto& entry = entries.back();
+            totalBytes -= entry.bytes;
+            for (auto& alias : entry.aliases) {
+                aliasMap.erase(alias);
+            }
+            entryMap.erase(entry.key);
+            entries.pop_back();
+        }
+    }
+
+}
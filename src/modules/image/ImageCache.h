@@ -0,0 +1,147 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017-present, cyder.org
+//  All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in the
+//  Software without restriction, including without limitation the rights to use, copy,
+//  modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//  and to permit persons to whom the Software is furnished to do so, subject to the
+//  following conditions:
+//
+//      The above copyright notice and this permission notice shall be included in all
+//      copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED *AS IS*, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//  PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CYDER_IMAGECACHE_H
+#define CYDER_IMAGECACHE_H
+
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <skia.h>
+#include "Image.h"
+
+namespace cyder {
+
+    struct ImageCacheStats {
+        /**
+         * The number of lookups that found a cached image.
+         */
+        uint64_t hits = 0;
+        /**
+         * The number of lookups that did not find a cached image.
+         */
+        uint64_t misses = 0;
+        /**
+         * The number of images in the cache.
+         */
+        size_t count = 0;
+        /**
+         * The total number of bytes of the images in the cache.
+         */
+        size_t bytes = 0;
+    };
+
+    /**
+     * ImageCache shares the decoded images between the loads of the same content. The images are keyed by a hash of
+     * their encoded bytes, so the same content at another path is shared too. A file is also registered as an alias
+     * of its content, keyed by its resolved path and modification time, so it is found again without reading it. The
+     * aliases cost nothing against the budget and go away with their entry. The least recently used images are
+     * evicted once the total size exceeds the budget. Evicting an image only drops the reference of the
+     * cache, the Image objects created from it keep it alive. The cache is accessed from the threads of the pool, all
+     * methods are thread-safe.
+     */
+    class ImageCache {
+    public:
+        /**
+         * Returns the image cache shared by all the image loaders.
+         */
+        static ImageCache* GetInstance();
+
+        /**
+         * Returns the alias key of the image loaded from a file, the key changes when the file is modified.
+         */
+        static std::string FileKey(const std::string& path, int64_t modifiedTime, size_t size,
+                                   const ImageDecodeOptions& options);
+
+        /**
+         * Returns the cache key of the image decoded from the encoded bytes.
+         */
+        static std::string DataKey(const void* bytes, size_t length, const ImageDecodeOptions& options);
+
+        /**
+         * Returns the cached image of the key, or nullptr if there is not one.
+         */
+        sk_sp<SkImage> find(const std::string& key);
+
+        /**
+         * Returns the cached image the alias refers to, or nullptr if the alias is unknown. Only a hit is counted in
+         * the stats, a miss is expected to be followed by a find() of the content key, which counts it.
+         */
+        sk_sp<SkImage> findAlias(const std::string& alias);
+
+        /**
+         * Makes the alias refer to the entry of the key, does nothing if the key is not cached.
+         */
+        void addAlias(const std::string& alias, const std::string& key);
+
+        /**
+         * Adds the image to the cache. If another image was added for the key in the meantime, that image is kept and
+         * returned instead, so the concurrent loads of the same content still share it.
+         * @param bytes The memory held by the image, its decoded pixels or its encoded data for a lazy image.
+         * @param cached Receives false if the image is too large for the budget and has not been cached.
+         */
+        sk_sp<SkImage> add(const std::string& key, sk_sp<SkImage> image, size_t bytes, bool* cached = nullptr);
+
+        /**
+         * Returns the maximum total size of the cached images in bytes.
+         */
+        size_t budget();
+
+        /**
+         * Sets the maximum total size of the cached images in bytes, 0 disables the cache.
+         */
+        void setBudget(size_t bytes);
+
+        ImageCacheStats stats();
+
+    private:
+        struct Entry {
+            std::string key;
+            sk_sp<SkImage> image;
+            size_t bytes;
+            std::vector<std::string> aliases;
+        };
+
+        ImageCache();
+
+        void purge();
+
+        std::mutex mutex;
+        std::list<Entry> entries;
+        std::unordered_map<std::string, std::list<Entry>::iterator> entryMap;
+        std::unordered_map<std::string, std::string> aliasMap;
+        size_t totalBytes = 0;
+        size_t byteLimit;
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+    };
+
+}
+
+#endif //CYDER_IMAGECACHE_H
@@ -0,0 +1,132 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017-present, cyder.org
+//  All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in the
+//  Software without restriction, including without limitation the rights to use, copy,
+//  modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//  and to permit persons to whom the Software is furnished to do so, subject to the
+//  following conditions:
+//
+//      The above copyright notice and this permission notice shall be included in all
+//      copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED *AS IS*, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//  PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "ImageDecoder.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace cyder {
+
+    static void FreePixels(const void* pixels, void* context) {
+        free(const_cast<void*>(pixels));
+    }
+
+    ImageDecoder* ImageDecoder::Make(sk_sp<SkData> data) {
+        if (!data || !data->size()) {
+            return nullptr;
+        }
+        auto codec = SkCodec::NewFromData(std::move(data));
+        if (!codec) {
+            return nullptr;
+        }
+        auto codecInfo = codec->getInfo();
+        auto info = SkImageInfo::MakeN32(codecInfo.width(), codecInfo.height(),
+                                         codecInfo.isOpaque() ? kOpaque_SkAlphaType : kPremul_SkAlphaType);
+        auto decoder = new ImageDecoder(codec, info);
+        if (!decoder->pixels) {
+            delete decoder;
+            return nullptr;
+        }
+        if (codec->getScanlineOrder() == SkCodec::kTopDown_SkScanlineOrder &&
+            codec->startScanlineDecode(info) == SkCodec::kSuccess) {
+            decoder->scanlineDecoding = true;
+            return decoder;
+        }
+        // The codec can only decode the whole image at once, decode it into a pending buffer of the full size.
+        decoder->pendingRows.resize(decoder->rowBytes * info.height());
+        if (codec->startIncrementalDecode(info, decoder->pendingRows.data(), decoder->rowBytes) != SkCodec::kSuccess) {
+            delete decoder;
+            return nullptr;
+        }
+        return decoder;
+    }
+
+    ImageDecoder::ImageDecoder(SkCodec* codec, const SkImageInfo& info) :
+            codec(codec), info(info), rowBytes(info.minRowBytes()) {
+        auto byteSize = rowBytes * info.height();
+        // The pixels are zeroed, so the rows not decoded yet are transparent.
+        pixels = static_cast<uint8_t*>(calloc(byteSize, 1));
+        if (pixels) {
+            pixelData = SkData::MakeWithProc(pixels, byteSize, FreePixels, nullptr);
+        }
+    }
+
+    void ImageDecoder::decodeRows(int maxRowCount) {
+        pendingRowStart = decodedRowCount;
+        if (!scanlineDecoding) {
+            auto result = codec->incrementalDecode();
+            // The pending buffer is zeroed, the rows left uninitialized by a truncated image are transparent.
+            if (result != SkCodec::kSuccess && result != SkCodec::kIncompleteInput) {
+                memset(pendingRows.data(), 0, pendingRows.size());
+            }
+            pendingRowCount = info.height();
+            decodedRowCount = info.height();
+            return;
+        }
+        int rowCount = std::min(std::max(maxRowCount, 1), info.height() - decodedRowCount);
+        pendingRows.resize(rowBytes * rowCount);
+        int rowsDecoded = codec->getScanlines(pendingRows.data(), rowCount, rowBytes);
+        pendingRowCount = rowCount;
+        decodedRowCount += rowCount;
+        if (rowsDecoded < rowCount) {
+            // The data is truncated, the codec has filled the rest of this slice, leave the other rows transparent.
+            decodedRowCount = info.height();
+        }
+    }
+
+    sk_sp<SkImage> ImageDecoder::commitRows(bool pixelsShared) {
+        if (pendingRowCount > 0) {
+            if (pixelsShared) {
+                // An image returned before is read elsewhere, e.g. by an encoding snapshot on another thread, so its
+                // pixels must not change. Copy the rows committed so far into new pixels, which are then written in
+                // place again until they get shared too.
+                auto byteSize = rowBytes * info.height();
+                auto newPixels = static_cast<uint8_t*>(calloc(byteSize, 1));
+                if (!newPixels) {
+                    // Out of memory, stop with the rows committed so far. The image is not complete.
+                    pendingRowCount = 0;
+                    decodedRowCount = committedRowCount = info.height();
+                    _failed = true;
+                    std::vector<uint8_t>().swap(pendingRows);
+                    return SkImage::MakeRasterData(info, pixelData, rowBytes);
+                }
+                memcpy(newPixels, pixels, rowBytes * pendingRowStart);
+                pixels = newPixels;
+                pixelData = SkData::MakeWithProc(pixels, byteSize, FreePixels, nullptr);
+            }
+            memcpy(pixels + rowBytes * pendingRowStart, pendingRows.data(), rowBytes * pendingRowCount);
+            pendingRowCount = 0;
+        }
+        committedRowCount = decodedRowCount;
+        if (finished()) {
+            std::vector<uint8_t>().swap(pendingRows);
+        }
+        return SkImage::MakeRasterData(info, pixelData, rowBytes);
+    }
+
+}
@@ -0,0 +1,110 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017-present, cyder.org
+//  All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in the
+//  Software without restriction, including without limitation the rights to use, copy,
+//  modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//  and to permit persons to whom the Software is furnished to do so, subject to the
+//  following conditions:
+//
+//      The above copyright notice and this permission notice shall be included in all
+//      copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED *AS IS*, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//  PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CYDER_IMAGEDECODER_H
+#define CYDER_IMAGEDECODER_H
+
+#include <memory>
+#include <vector>
+#include <skia.h>
+
+namespace cyder {
+
+    /**
+     * ImageDecoder decodes an image progressively, a bounded number of rows at a time, so that decoding a very large
+     * image can be spread over many slices and the rows decoded so far can be drawn in the meantime. The rows are
+     * decoded on a thread of the pool into a pending buffer, and then committed into the pixels on the main thread, so
+     * the pixels drawn are never written concurrently. The calls must not overlap, each slice is started after the
+     * last one is committed.
+     */
+    class ImageDecoder {
+    public:
+        /**
+         * Creates a decoder of the encoded data, returns nullptr if the data is not a supported image.
+         */
+        static ImageDecoder* Make(sk_sp<SkData> data);
+
+        int width() const {
+            return info.width();
+        }
+
+        int height() const {
+            return info.height();
+        }
+
+        /**
+         * Returns true if all rows have been committed.
+         */
+        bool finished() const {
+            return committedRowCount == info.height();
+        }
+
+        /**
+         * Decodes the rows following the ones already decoded into the pending buffer, runs on a thread of the pool.
+         * The formats that cannot be decoded line by line, e.g. GIF and BMP, are decoded in one slice. If the image
+         * data is truncated or corrupted, the remaining rows are left transparent and the decoding finishes.
+         * @param maxRowCount The maximum number of rows to decode.
+         */
+        void decodeRows(int maxRowCount);
+
+        /**
+         * Copies the pending rows into the pixels and returns an image of the pixels decoded so far, with the
+         * remaining rows transparent, runs on the main thread. The returned image shares the pixels of the decoder,
+         * no copy is made.
+         * @param pixelsShared Whether the last image returned is referenced by anything but its Image object, e.g. an
+         * encoding snapshot read on another thread. If so, the rows are committed into a copy of the pixels, leaving
+         * the pixels of that image untouched.
+         */
+        sk_sp<SkImage> commitRows(bool pixelsShared);
+
+        /**
+         * Returns true if the decoding has stopped before the end of the image because the pixels could not be copied.
+         * The image is then not complete and must not be cached.
+         */
+        bool failed() const {
+            return _failed;
+        }
+
+    private:
+        ImageDecoder(SkCodec* codec, const SkImageInfo& info);
+
+        std::unique_ptr<SkCodec> codec;
+        SkImageInfo info;
+        size_t rowBytes;
+        uint8_t* pixels;
+        sk_sp<SkData> pixelData;
+        bool scanlineDecoding = false;
+        std::vector<uint8_t> pendingRows;
+        int pendingRowStart = 0;
+        int pendingRowCount = 0;
+        int decodedRowCount = 0;
+        int committedRowCount = 0;
+        bool _failed = false;
+    };
+
+}
+
+#endif //CYDER_IMAGEDECODER_H
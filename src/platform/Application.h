@@ -27,6 +27,7 @@
 #ifndef CYDER_APPLICATION_H
 #define CYDER_APPLICATION_H
 
+#include <functional>
 #include "Window.h"
 
 namespace cyder {
@@ -46,6 +47,11 @@ namespace cyder {
         virtual void run() = 0;
 
         virtual void exit(int errorCode = 0) = 0;
+
+        /**
+         * Posts a task to run on the main thread, after the current task. It is safe to call from any thread.
+         */
+        virtual void postTask(const std::function<void()>& task) = 0;
     };
 
 
@@ -0,0 +1,54 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017-present, cyder.org
+//  All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in the
+//  Software without restriction, including without limitation the rights to use, copy,
+//  modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//  and to permit persons to whom the Software is furnished to do so, subject to the
+//  following conditions:
+//
+//      The above copyright notice and this permission notice shall be included in all
+//      copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED *AS IS*, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//  PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CYDER_FILEDATA_H
+#define CYDER_FILEDATA_H
+
+#include <cstdint>
+#include <string>
+#include <skia.h>
+
+namespace cyder {
+
+    class FileData {
+    public:
+        /**
+         * Maps the file at the path into memory and returns it as a read-only SkData, the pages are read from the page
+         * cache on demand and unmapped when the SkData is released. Returns nullptr if the file cannot be opened or is
+         * empty.
+         */
+        static sk_sp<SkData> MapFile(const std::string& path);
+
+        /**
+         * Reads the last modification time (in seconds since the epoch) and the size of the file at the path. Returns
+         * false if the file does not exist or is not a regular file.
+         */
+        static bool GetFileInfo(const std::string& path, int64_t* modifiedTime, size_t* size);
+    };
+
+}  // namespace cyder
+
+#endif //CYDER_FILEDATA_H
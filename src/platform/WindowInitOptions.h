@@ -40,7 +40,9 @@ namespace cyder {
      */
     class WindowInitOptions final {
     public:
-        WindowInitOptions() : maximizable(true),
+        WindowInitOptions() : width(500),
+                              height(400),
+                              maximizable(true),
                               minimizable(true),
                               resizable(true),
                               transparent(false),
@@ -48,6 +50,14 @@ namespace cyder {
                               systemChrome(WindowSystemChrome::STANDARD),
                               type(WindowType::NORMAL) {}
 
+        /**
+         * The initial width of the content area of the window, in points.
+         */
+        float width;
+        /**
+         * The initial height of the content area of the window, in points.
+         */
+        float height;
         bool maximizable;
         bool minimizable;
         bool resizable;
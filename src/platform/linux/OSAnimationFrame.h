@@ -0,0 +1,115 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017-present, cyder.org
+//  All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in the
+//  Software without restriction, including without limitation the rights to use, copy,
+//  modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//  and to permit persons to whom the Software is furnished to do so, subject to the
+//  following conditions:
+//
+//      The above copyright notice and this permission notice shall be included in all
+//      copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED *AS IS*, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//  PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef CYDER_OSANIMATIONFRAME_H
+#define CYDER_OSANIMATIONFRAME_H
+
+#include <map>
+#include "platform/AnimationFrame.h"
+
+namespace cyder {
+
+    /**
+     * A frame clock for headless environments. There is no display to synchronize with, so frames are scheduled at a
+     * fixed interval and driven by OSApplication::run().
+     */
+    class OSAnimationFrame {
+    public:
+        static OSAnimationFrame* Current() {
+            return animationFrame;
+        }
+
+        static void RequestScreenUpdate() {
+            if (animationFrame->needUpdateScreen) {
+                return;
+            }
+            animationFrame->needUpdateScreen = true;
+            animationFrame->requestNextFrame();
+        }
+
+        static unsigned long Request(FrameRequestCallback callback) {
+            auto handle = ++animationFrame->lastHandle;
+            animationFrame->callbacks[handle] = callback;
+            animationFrame->requestNextFrame();
+            return handle;
+        }
+
+        static void Cancel(unsigned long handle) {
+            animationFrame->callbacks.erase(handle);
+        }
+
+        static void ForceScreenUpdateNow() {
+            animationFrame->needUpdateScreen = true;
+            animationFrame->presentScreens();
+        }
+
+        /**
+         * Creates a frame clock.
+         * @param frameRate The number of frames per second. Pass 0 to run frames back to back without throttling.
+         */
+        explicit OSAnimationFrame(double frameRate = 60);
+        ~OSAnimationFrame();
+
+        /**
+         * Indicates whether a frame has been requested since the last update.
+         */
+        bool hasNextFrame() const {
+            return _hasNextFrame;
+        }
+
+        /**
+         * Returns the time at which the next frame is due, in the same time base as GetTimer().
+         */
+        double nextFrameTime() const {
+            return lastFrameTime + frameInterval;
+        }
+
+        void update();
+
+    private:
+        static OSAnimationFrame* animationFrame;
+
+        /**
+         * The callbacks requested for the next frame keyed by their handles, which are never reused, so cancelling a
+         * callback does not affect the handles of the others. The map runs them in the order they were requested.
+         */
+        std::map<unsigned long, FrameRequestCallback> callbacks;
+        unsigned long lastHandle = 0;
+        double frameInterval;
+        double lastFrameTime = 0;
+        bool needUpdateScreen = false;
+        bool _hasNextFrame = false;
+
+        void requestNextFrame() {
+            _hasNextFrame = true;
+        }
+
+        void presentScreens();
+    };
+}
+
+#endif  //CYDER_OSANIMATIONFRAME_H
@@ -0,0 +1,128 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017-present, cyder.org
+//  All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in the
+//  Software without restriction, including without limitation the rights to use, copy,
+//  modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//  and to permit persons to whom the Software is furnished to do so, subject to the
+//  following conditions:
+//
+//      The above copyright notice and this permission notice shall be included in all
+//      copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED *AS IS*, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//  PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <algorithm>
+#include <chrono>
+#include "OSApplication.h"
+#include "OSAnimationFrame.h"
+#include "utils/GetTimer.h"
+#include "base/ThreadPool.h"
+
+namespace cyder {
+
+    Application* Application::application = nullptr;
+
+    OSApplication::OSApplication() : _openedWindows(new std::vector<OSWindow*>()) {
+        Application::application = this;
+    }
+
+    OSApplication::~OSApplication() {
+        delete _openedWindows;
+        Application::application = nullptr;
+    }
+
+    void OSApplication::exit(int errorCode) {
+        if (errorCode == 0) {
+            running = false;
+        } else {
+            ::exit(errorCode);
+        }
+    }
+
+    void OSApplication::run() {
+        running = true;
+        auto animationFrame = OSAnimationFrame::Current();
+        while (running) {
+            runPendingTasks();
+            if (!running) {
+                break;
+            }
+            bool hasNextFrame = animationFrame->hasNextFrame();
+            std::unique_lock<std::mutex> lock(taskMutex);
+            if (!tasks.empty()) {
+                continue;
+            }
+            if (hasNextFrame) {
+                auto delay = animationFrame->nextFrameTime() - GetTimer();
+                if (delay > 0) {
+                    // Wake up early if a task is posted in the meantime.
+                    taskCondition.wait_for(lock, std::chrono::duration<double, std::milli>(delay),
+                                           [this]() { return !tasks.empty(); });
+                    if (!tasks.empty()) {
+                        continue;
+                    }
+                }
+                lock.unlock();
+                animationFrame->update();
+            } else if (ThreadPool::PendingReplyCount() > 0) {
+                // Nothing to draw, wait for the background work to post its replies.
+                taskCondition.wait(lock, [this]() { return !tasks.empty(); });
+            } else {
+                break;
+            }
+        }
+        running = false;
+    }
+
+    void OSApplication::postTask(const std::function<void()>& task) {
+        {
+            std::lock_guard<std::mutex> lock(taskMutex);
+            tasks.push_back(task);
+        }
+        taskCondition.notify_one();
+    }
+
+    void OSApplication::runPendingTasks() {
+        std::deque<std::function<void()>> currentTasks;
+        {
+            std::lock_guard<std::mutex> lock(taskMutex);
+            currentTasks.swap(tasks);
+        }
+        // The tasks posted while running these ones are run on the next turn of the loop.
+        for (auto& task : currentTasks) {
+            task();
+        }
+    }
+
+    void OSApplication::windowOpened(OSWindow* window) {
+        auto windows = _openedWindows;
+        auto result = std::find(windows->begin(), windows->end(), window);
+        if (result == windows->end()) {
+            windows->push_back(window);
+        }
+    }
+
+    void OSApplication::windowClosed(OSWindow* window) {
+        auto windows = _openedWindows;
+        auto result = std::find(windows->begin(), windows->end(), window);
+        if (result != windows->end()) {
+            windows->erase(result);
+        }
+    }
+
+
+} // namespace cyder
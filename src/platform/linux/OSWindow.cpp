@@ -0,0 +1,144 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017-present, cyder.org
+//  All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in the
+//  Software without restriction, including without limitation the rights to use, copy,
+//  modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//  and to permit persons to whom the Software is furnished to do so, subject to the
+//  following conditions:
+//
+//      The above copyright notice and this permission notice shall be included in all
+//      copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED *AS IS*, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//  PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "OSWindow.h"
+#include "OSApplication.h"
+#include "OSAnimationFrame.h"
+
+namespace cyder {
+
+    Window* Window::New(const WindowInitOptions &initOptions) {
+        return new OSWindow(initOptions);
+    }
+
+    OSWindow::OSWindow(const WindowInitOptions &initOptions) :
+            _contentWidth(initOptions.width), _contentHeight(initOptions.height) {
+        _screenBuffer = new ScreenBuffer(this);
+        _screenBuffer->updateSize(SkScalarRoundToInt(_contentWidth), SkScalarRoundToInt(_contentHeight));
+    }
+
+    OSWindow::~OSWindow() {
+        if (opened) {
+            auto app = static_cast<OSApplication*>(Application::application);
+            app->windowClosed(this);
+        }
+        delete _screenBuffer;
+    }
+
+    void OSWindow::activate() {
+        auto app = static_cast<OSApplication*>(Application::application);
+        if (!opened) {
+            opened = true;
+            app->windowOpened(this);
+        }
+        if (delegate) {
+            delegate->onFocusIn();
+        }
+        OSAnimationFrame::ForceScreenUpdateNow();
+    }
+
+
+    void OSWindow::close() {
+        if (delegate && !delegate->onClosing()) {
+            return;
+        }
+        if (opened) {
+            opened = false;
+            auto app = static_cast<OSApplication*>(Application::application);
+            app->windowClosed(this);
+        }
+        _screenBuffer->dispose();
+        // The delegate may delete this window, so do not touch any member after calling onClosed().
+        if (delegate) {
+            delegate->onClosed();
+        }
+    }
+
+
+    std::string OSWindow::title() {
+        return _title;
+    }
+
+    void OSWindow::setTitle(const std::string &title) {
+        _title = title;
+    }
+
+    float OSWindow::x() const {
+        return _x;
+    }
+
+    void OSWindow::setX(float value) {
+        _x = value;
+    }
+
+    float OSWindow::y() const {
+        return _y;
+    }
+
+    void OSWindow::setY(float value) {
+        _y = value;
+    }
+
+    float OSWindow::width() const {
+        return _contentWidth;
+    }
+
+    float OSWindow::height() const {
+        return _contentHeight;
+    }
+
+
+    float OSWindow::contentWidth() const {
+        return _contentWidth;
+    }
+
+    float OSWindow::contentHeight() const {
+        return _contentHeight;
+    }
+
+    void OSWindow::setContentSize(float width, float height) {
+        if (width == _contentWidth && height == _contentHeight) {
+            return;
+        }
+        _contentWidth = width;
+        _contentHeight = height;
+        _screenBuffer->updateSize(SkScalarRoundToInt(width), SkScalarRoundToInt(height));
+        if (delegate) {
+            delegate->onResized();
+            OSAnimationFrame::ForceScreenUpdateNow();
+        }
+    }
+
+    float OSWindow::scaleFactor() const {
+        return 1;
+    }
+
+    void OSWindow::setDelegate(WindowDelegate* delegate) {
+        this->delegate = delegate;
+    }
+
+} // namespace cyder
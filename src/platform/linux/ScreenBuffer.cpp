@@ -0,0 +1,164 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017-present, cyder.org
+//  All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in the
+//  Software without restriction, including without limitation the rights to use, copy,
+//  modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//  and to permit persons to whom the Software is furnished to do so, subject to the
+//  following conditions:
+//
+//      The above copyright notice and this permission notice shall be included in all
+//      copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED *AS IS*, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//  PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "ScreenBuffer.h"
+#include "OSWindow.h"
+#include "OSAnimationFrame.h"
+#include "platform/SurfaceFactory.h"
+#include <cstring>
+
+namespace cyder {
+
+    /**
+     * The maximum number of rects in the dirty region before it is merged into its bounds.
+     */
+    static const int MAX_DIRTY_RECT_COUNT = 16;
+
+    ScreenBuffer::ScreenBuffer(OSWindow* window) : window(window) {
+    }
+
+    ScreenBuffer::~ScreenBuffer() {
+        SkSafeUnref(_surface);
+        SkSafeUnref(_screen);
+    }
+
+    void ScreenBuffer::updateSize(int width, int height) {
+        if (!isValid) {
+            return;
+        }
+        _width = width;
+        _height = height;
+        invalidateSize();
+    }
+
+    void ScreenBuffer::setWidth(int value) {
+        if (!isValid || value < 0) {
+            return;
+        }
+        invalidateSize();
+        _width = value;
+        window->setContentSize(_width, _height);
+    }
+
+    void ScreenBuffer::setHeight(int value) {
+        if (!isValid || value < 0) {
+            return;
+        }
+        invalidateSize();
+        _height = value;
+        window->setContentSize(_width, _height);
+    }
+
+    SkCanvas* ScreenBuffer::getCanvas() {
+        addDirtyRect(SkIRect::MakeWH(_width, _height));
+        return getSurface()->getCanvas();
+    }
+
+    SkCanvas* ScreenBuffer::getCanvasForRect(const SkIRect& dirtyRect) {
+        addDirtyRect(dirtyRect);
+        return getSurface()->getCanvas();
+    }
+
+    void ScreenBuffer::addDirtyRect(const SkIRect& rect) {
+        auto dirtyRect = rect;
+        if (!dirtyRect.intersect(SkIRect::MakeWH(_width, _height))) {
+            return;
+        }
+        if (!contentChanged) {
+            contentChanged = true;
+            OSAnimationFrame::RequestScreenUpdate();
+        }
+        dirtyRegion.op(dirtyRect, SkRegion::kUnion_Op);
+        // Many small scattered rects cost more to present one by one than their bounds at once.
+        if (dirtyRegion.computeRegionComplexity() > MAX_DIRTY_RECT_COUNT) {
+            dirtyRegion.setRect(dirtyRegion.getBounds());
+        }
+    }
+
+    void ScreenBuffer::draw(SkCanvas* canvas, SkScalar x, SkScalar y, const SkPaint* paint) {
+        getSurface()->draw(canvas, x, y, paint);
+    }
+
+    Image* ScreenBuffer::makeImageSnapshot() {
+        auto image = getSurface()->makeImageSnapshot().release();
+        return new Image(image);
+    }
+
+    bool ScreenBuffer::peekPixels(SkPixmap* pixmap, const SkIRect* writeRect) {
+        if (writeRect) {
+            addDirtyRect(*writeRect);
+            // Copies the pixels on write if a snapshot shares them.
+            getSurface()->notifyContentWillChange(SkSurface::kRetain_ContentChangeMode);
+        }
+        return getSurface()->peekPixels(pixmap);
+    }
+
+    bool ScreenBuffer::readPixels(const SkImageInfo& info, void* pixels, size_t rowBytes, int x, int y) {
+        return getSurface()->readPixels(info, pixels, rowBytes, x, y);
+    }
+
+    bool ScreenBuffer::writePixels(const SkImageInfo& info, const void* pixels, size_t rowBytes, int x, int y) {
+        addDirtyRect(SkIRect::MakeXYWH(x, y, info.width(), info.height()));
+        return getSurface()->getCanvas()->writePixels(info, pixels, rowBytes, x, y);
+    }
+
+    SkSurface* ScreenBuffer::getSurface() {
+        if (_surface) {
+            return _surface;
+        }
+        _surface = SurfaceFactory::MakeRaster(_width, _height);
+        return _surface;
+    }
+
+    void ScreenBuffer::present() {
+        if (!isValid || !contentChanged) {
+            return;
+        }
+        contentChanged = false;
+        if (!_screen) {
+            _screen = SurfaceFactory::MakeRaster(_width, _height);
+            dirtyRegion.setRect(SkIRect::MakeWH(_width, _height));
+        }
+        SkPixmap src;
+        SkPixmap dst;
+        if (!getSurface()->peekPixels(&src) || !_screen->peekPixels(&dst)) {
+            dirtyRegion.setEmpty();
+            return;
+        }
+        // Both buffers have the same format, copy the rows of each dirty rect as they are.
+        for (SkRegion::Iterator iter(dirtyRegion); !iter.done(); iter.next()) {
+            auto& rect = iter.rect();
+            auto rowBytes = static_cast<size_t>(rect.width()) * 4;
+            for (int y = rect.fTop; y < rect.fBottom; y++) {
+                memcpy(dst.writable_addr32(rect.fLeft, y), src.addr32(rect.fLeft, y), rowBytes);
+            }
+        }
+        dirtyRegion.setEmpty();
+    }
+
+
+}  // namespace cyder
@@ -0,0 +1,139 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017-present, cyder.org
+//  All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in the
+//  Software without restriction, including without limitation the rights to use, copy,
+//  modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//  and to permit persons to whom the Software is furnished to do so, subject to the
+//  following conditions:
+//
+//      The above copyright notice and this permission notice shall be included in all
+//      copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED *AS IS*, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//  PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef CYDER_SCREENUBFFER_H
+#define CYDER_SCREENUBFFER_H
+
+#include <skia.h>
+#include "modules/canvas/DrawingBuffer.h"
+
+namespace cyder {
+
+    class OSWindow;
+
+    /**
+     * A raster DrawingBuffer for headless windows. Drawing goes into a back buffer, present() copies it into the front
+     * buffer, which stands in for the window contents.
+     */
+    class ScreenBuffer : public DrawingBuffer {
+    public:
+        ScreenBuffer(OSWindow* window);
+        ~ScreenBuffer();
+
+        /**
+         * Updates the size of the ScreenBuffer.
+         * @param width The width of the ScreenBuffer, in pixels.
+         * @param height The height of the ScreenBuffer, in pixels.
+         */
+        void updateSize(int width, int height);
+
+        /**
+        * Indicates the width of the ScreenBuffer, in pixels.
+        */
+        int width() const override {
+            return _width;
+        }
+
+        void setWidth(int value) override;
+
+        /**
+         * Indicates the height of the ScreenBuffer, in pixels.
+         */
+        int height() const override {
+            return _height;
+        }
+
+        void setHeight(int value) override;
+
+        /**
+         * Return a canvas that will draw into this drawing buffer.
+         * Note: Do not cache the return value of surface(), it may change when DrawingBuffer resizes.
+         */
+        SkCanvas* getCanvas() override;
+
+        SkCanvas* getCanvasForRect(const SkIRect& dirtyRect) override;
+
+        /**
+         * Draws this buffer directly into another canvas.
+         */
+        void draw(SkCanvas* canvas, SkScalar x, SkScalar y, const SkPaint* paint) override;
+
+        Image* makeImageSnapshot() override;
+
+        bool peekPixels(SkPixmap* pixmap, const SkIRect* writeRect) override;
+
+        bool readPixels(const SkImageInfo& info, void* pixels, size_t rowBytes, int x, int y) override;
+
+        bool writePixels(const SkImageInfo& info, const void* pixels, size_t rowBytes, int x, int y) override;
+
+        /**
+         * Copies all drawing applied to the back buffer since the last call into the front buffer. Only the areas that
+         * changed are copied.
+         */
+        void present();
+
+        /**
+         * Marks the ScreenBuffer as invalid. When the dispose() method is called on a ScreenBuffer, all subsequent
+         * calls to methods of this ScreenBuffer instance are ignored.
+         */
+        void dispose() {
+            isValid = false;
+        }
+
+    private:
+        bool contentChanged = false;
+        OSWindow* window;
+        SkSurface* _surface = nullptr;
+        SkSurface* _screen = nullptr;
+        bool isValid = true;
+        int _width = 0;
+        int _height = 0;
+
+        /**
+         * The areas drawn since the last present(), only these areas are copied to the screen.
+         */
+        SkRegion dirtyRegion;
+
+        SkSurface* getSurface();
+
+        void addDirtyRect(const SkIRect& rect);
+
+        void invalidateSize() {
+            if (_surface) {
+                SkSafeUnref(_surface);
+                _surface = nullptr;
+            }
+            if (_screen) {
+                SkSafeUnref(_screen);
+                _screen = nullptr;
+            }
+        }
+    };
+
+}  // namespace cyder
+
+#endif //CYDER_SCREENUBFFER_H
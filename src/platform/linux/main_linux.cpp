@@ -0,0 +1,57 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017-present, cyder.org
+//  All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in the
+//  Software without restriction, including without limitation the rights to use, copy,
+//  modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//  and to permit persons to whom the Software is furnished to do so, subject to the
+//  following conditions:
+//
+//      The above copyright notice and this permission notice shall be included in all
+//      copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED *AS IS*, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//  PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include "OSApplication.h"
+#include "OSAnimationFrame.h"
+
+using namespace cyder;
+
+static const char FRAME_RATE_FLAG[] = "--frame-rate=";
+
+int main(int argc, char* argv[]) {
+    signal(SIGPIPE, SIG_IGN);
+
+    // Consume the --frame-rate=<fps> flag, passing 0 renders frames back to back.
+    double frameRate = 60;
+    int count = 0;
+    for (int i = 0; i < argc; i++) {
+        if (strncmp(argv[i], FRAME_RATE_FLAG, sizeof(FRAME_RATE_FLAG) - 1) == 0) {
+            frameRate = atof(argv[i] + sizeof(FRAME_RATE_FLAG) - 1);
+            continue;
+        }
+        argv[count++] = argv[i];
+    }
+    argc = count;
+
+    OSApplication app;
+    OSAnimationFrame animationFrame(frameRate);
+
+    return Start(argc, argv);
+}
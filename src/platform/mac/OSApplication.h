@@ -46,6 +46,8 @@ namespace cyder {
         void exit(int errorCode = 0) override;
 
         void run() override;
+
+        void postTask(const std::function<void()>& task) override;
         
         const std::vector<OSWindow*>* openedWindows() const {
             return _openedWindows;
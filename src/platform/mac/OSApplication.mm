@@ -59,6 +59,14 @@ namespace cyder {
         [nsApp run];
     }
 
+    void OSApplication::postTask(const std::function<void()>& task) {
+        // The block keeps its own copy of the task.
+        std::function<void()> callback = task;
+        dispatch_async(dispatch_get_main_queue(), ^{
+            callback();
+        });
+    }
+
     void OSApplication::windowOpened(OSWindow* window) {
         auto windows = _openedWindows;
         auto result = std::find(windows->begin(), windows->end(), window);
@@ -198,7 +198,7 @@ namespace cyder {
     }
 
     NSWindow* OSWindow::createNSWindow(const WindowInitOptions &options) {
-        NSRect contentSize = NSMakeRect(0, 0, 500, 400);
+        NSRect contentSize = NSMakeRect(0, 0, options.width, options.height);
         NSWindowStyleMask windowStyleMask = NSClosableWindowMask;
         if (options.systemChrome == WindowSystemChrome::STANDARD) {
             windowStyleMask |= NSTitledWindowMask;
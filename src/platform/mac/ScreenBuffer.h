@@ -74,6 +74,8 @@ namespace cyder {
          */
         SkCanvas* getCanvas() override;
 
+        SkCanvas* getCanvasForRect(const SkIRect& dirtyRect) override;
+
         /**
          * Draws this buffer directly into another canvas.
          */
@@ -81,8 +83,15 @@ namespace cyder {
 
         Image* makeImageSnapshot() override;
 
+        bool peekPixels(SkPixmap* pixmap, const SkIRect* writeRect) override;
+
+        bool readPixels(const SkImageInfo& info, void* pixels, size_t rowBytes, int x, int y) override;
+
+        bool writePixels(const SkImageInfo& info, const void* pixels, size_t rowBytes, int x, int y) override;
+
         /**
-         * Call to ensure all drawing to the surface has been applied to the Window.
+         * Call to ensure all drawing to the surface has been applied to the Window. Only the areas that changed are
+         * drawn to the Window.
          */
         void present();
 
@@ -114,8 +123,15 @@ namespace cyder {
         int _width = 0;
         int _height = 0;
 
+        /**
+         * The areas drawn since the last present(), only these areas are copied to the screen.
+         */
+        SkRegion dirtyRegion;
+
         SkSurface* getSurface();
 
+        void addDirtyRect(const SkIRect& rect);
+
         void invalidateSize() {
             if (_surface) {
                 SkSafeUnref(_surface);
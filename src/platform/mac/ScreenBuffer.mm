@@ -35,6 +35,11 @@
 
 namespace cyder {
 
+    /**
+     * The maximum number of rects in the dirty region before it is merged into its bounds.
+     */
+    static const int MAX_DIRTY_RECT_COUNT = 16;
+
     ScreenBuffer::ScreenBuffer(OSWindow* window) : window(window) {
     }
 
@@ -70,6 +75,8 @@ namespace cyder {
                 kCGLPFAStencilSize, (CGLPixelFormatAttribute) 8,
                 kCGLPFAAccelerated,
                 kCGLPFADoubleBuffer,
+                // Keep the back buffer after swapping, present() only redraws the dirty areas.
+                kCGLPFABackingStore,
                 kCGLPFAOpenGLProfile, (CGLPixelFormatAttribute) kCGLOGLPVersion_3_2_Core,
                 (CGLPixelFormatAttribute) 0
         };
@@ -132,11 +139,29 @@ namespace cyder {
     }
 
     SkCanvas* ScreenBuffer::getCanvas() {
-        if(!contentChanged){
+        addDirtyRect(SkIRect::MakeWH(_width, _height));
+        return getSurface()->getCanvas();
+    }
+
+    SkCanvas* ScreenBuffer::getCanvasForRect(const SkIRect& dirtyRect) {
+        addDirtyRect(dirtyRect);
+        return getSurface()->getCanvas();
+    }
+
+    void ScreenBuffer::addDirtyRect(const SkIRect& rect) {
+        auto dirtyRect = rect;
+        if (!dirtyRect.intersect(SkIRect::MakeWH(_width, _height))) {
+            return;
+        }
+        if (!contentChanged) {
             contentChanged = true;
             OSAnimationFrame::RequestScreenUpdate();
         }
-        return getSurface()->getCanvas();
+        dirtyRegion.op(dirtyRect, SkRegion::kUnion_Op);
+        // Many small scattered rects cost more to present one by one than their bounds at once.
+        if (dirtyRegion.computeRegionComplexity() > MAX_DIRTY_RECT_COUNT) {
+            dirtyRegion.setRect(dirtyRegion.getBounds());
+        }
     }
 
     void ScreenBuffer::draw(SkCanvas* canvas, SkScalar x, SkScalar y, const SkPaint* paint) {
@@ -148,6 +173,24 @@ namespace cyder {
         return new Image(image);
     }
 
+    bool ScreenBuffer::peekPixels(SkPixmap* pixmap, const SkIRect* writeRect) {
+        if (writeRect) {
+            addDirtyRect(*writeRect);
+            // Copies the pixels on write if a snapshot shares them.
+            getSurface()->notifyContentWillChange(SkSurface::kRetain_ContentChangeMode);
+        }
+        return getSurface()->peekPixels(pixmap);
+    }
+
+    bool ScreenBuffer::readPixels(const SkImageInfo& info, void* pixels, size_t rowBytes, int x, int y) {
+        return getSurface()->readPixels(info, pixels, rowBytes, x, y);
+    }
+
+    bool ScreenBuffer::writePixels(const SkImageInfo& info, const void* pixels, size_t rowBytes, int x, int y) {
+        addDirtyRect(SkIRect::MakeXYWH(x, y, info.width(), info.height()));
+        return getSurface()->getCanvas()->writePixels(info, pixels, rowBytes, x, y);
+    }
+
     SkSurface* ScreenBuffer::getSurface() {
         if (_surface) {
             return _surface;
@@ -177,9 +220,19 @@ namespace cyder {
             glClear(GL_STENCIL_BUFFER_BIT);
             [openGLContext update];
             _screen = SkSurface::MakeFromBackendRenderTarget(grContext, desc, nullptr).release();
+            dirtyRegion.setRect(SkIRect::MakeWH(_width, _height));
         }
         auto canvas = _screen->getCanvas();
-        getSurface()->draw(canvas, 0, 0, nullptr);
+        SkPaint paint;
+        paint.setBlendMode(SkBlendMode::kSrc);
+        // Rect clips are applied as scissor tests on the GPU, only the dirty areas are redrawn.
+        for (SkRegion::Iterator iter(dirtyRegion); !iter.done(); iter.next()) {
+            canvas->save();
+            canvas->clipRect(SkRect::Make(iter.rect()));
+            getSurface()->draw(canvas, 0, 0, &paint);
+            canvas->restore();
+        }
+        dirtyRegion.setEmpty();
         grContext->flush();
         [openGLContext flushBuffer];
     }
@@ -0,0 +1,72 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017-present, cyder.org
+//  All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in the
+//  Software without restriction, including without limitation the rights to use, copy,
+//  modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//  and to permit persons to whom the Software is furnished to do so, subject to the
+//  following conditions:
+//
+//      The above copyright notice and this permission notice shall be included in all
+//      copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED *AS IS*, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//  PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "platform/FileData.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace cyder {
+
+    static void UnmapFile(const void* addr, void* context) {
+        munmap(const_cast<void*>(addr), reinterpret_cast<size_t>(context));
+    }
+
+    sk_sp<SkData> FileData::MapFile(const std::string& path) {
+        int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return nullptr;
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size <= 0) {
+            close(fd);
+            return nullptr;
+        }
+        auto length = static_cast<size_t>(info.st_size);
+        void* addr = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        // The mapping stays valid after the descriptor is closed.
+        close(fd);
+        if (addr == MAP_FAILED) {
+            return nullptr;
+        }
+        // The codec reads the file from the start to the end.
+        madvise(addr, length, MADV_SEQUENTIAL);
+        return SkData::MakeWithProc(addr, length, UnmapFile, reinterpret_cast<void*>(length));
+    }
+
+    bool FileData::GetFileInfo(const std::string& path, int64_t* modifiedTime, size_t* size) {
+        struct stat info;
+        if (stat(path.c_str(), &info) != 0 || !S_ISREG(info.st_mode)) {
+            return false;
+        }
+        *modifiedTime = static_cast<int64_t>(info.st_mtime);
+        *size = static_cast<size_t>(info.st_size);
+        return true;
+    }
+
+} // namespace cyder
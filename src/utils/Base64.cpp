@@ -26,6 +26,15 @@
 
 
 #include "Base64.h"
+#include <cstdint>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+// The blocks are compiled for SSSE3 with a function attribute instead of building the whole file with -mssse3, which
+// would let the compiler emit SSSE3 instructions in the scalar code too. They only run if the CPU supports them.
+#define BASE64_SSSE3
+#define SSSE3_TARGET __attribute__((target("ssse3")))
+#include <tmmintrin.h>
+#endif
 
 namespace cyder {
 
@@ -40,91 +49,238 @@ namespace cyder {
             0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x2B, 0x2F
     };
 
-    static const char base64DecMap[128] = {
-            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-            0x00, 0x00, 0x00, 0x3E, 0x00, 0x00, 0x00, 0x3F,
+    /**
+     * Maps the base64 characters to their 6-bit values, 0xFF marks the invalid characters.
+     */
+    static const uint8_t base64DecMap[256] = {
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0x3E, 0xFF, 0xFF, 0xFF, 0x3F,
             0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B,
-            0x3C, 0x3D, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-            0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06,
+            0x3C, 0x3D, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06,
             0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
             0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16,
-            0x17, 0x18, 0x19, 0x00, 0x00, 0x00, 0x00, 0x00,
-            0x00, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20,
+            0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20,
             0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
             0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30,
-            0x31, 0x32, 0x33, 0x00, 0x00, 0x00, 0x00, 0x00
+            0x31, 0x32, 0x33, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
     };
 
+#ifdef BASE64_SSSE3
+
+    /**
+     * Encodes 12 bytes to 16 characters, reads 16 bytes from the source.
+     */
+    SSSE3_TARGET static inline __m128i EncodeBlock(const char* bytes) {
+        auto input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes));
+        // Spread the 3-byte groups into 32-bit lanes as [b1, b0, b2, b1].
+        input = _mm_shuffle_epi8(input, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+        // Move each of the four 6-bit fields of a lane into its own byte.
+        auto t0 = _mm_and_si128(input, _mm_set1_epi32(0x0fc0fc00));
+        auto t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+        auto t2 = _mm_and_si128(input, _mm_set1_epi32(0x003f03f0));
+        auto t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+        auto indices = _mm_or_si128(t1, t3);
+        // Map the 6-bit values to characters by adding an offset looked up from the range they fall in.
+        auto offsetIndices = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+        auto lessThan26 = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+        offsetIndices = _mm_or_si128(offsetIndices, _mm_and_si128(lessThan26, _mm_set1_epi8(13)));
+        const auto offsets = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                           '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+        return _mm_add_epi8(_mm_shuffle_epi8(offsets, offsetIndices), indices);
+    }
+
+    /**
+     * Decodes 16 characters to 12 bytes, writes 16 bytes to the destination. Returns false if any of the characters is
+     * not a base64 character, including the padding.
+     */
+    SSSE3_TARGET static inline bool DecodeBlock(const char* text, char* result) {
+        auto input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text));
+        auto highNibbles = _mm_and_si128(_mm_srli_epi32(input, 4), _mm_set1_epi8(0x0f));
+        auto lowNibbles = _mm_and_si128(input, _mm_set1_epi8(0x0f));
+        // A character is valid if the bit sets looked up by its low and high nibbles do not intersect.
+        const auto lowLookup = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                             0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+        const auto highLookup = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                              0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+        auto low = _mm_shuffle_epi8(lowLookup, lowNibbles);
+        auto high = _mm_shuffle_epi8(highLookup, highNibbles);
+        auto invalid = _mm_cmpeq_epi8(_mm_and_si128(low, high), _mm_setzero_si128());
+        if (_mm_movemask_epi8(invalid) != 0xFFFF) {
+            return false;
+        }
+        // Map the characters to their 6-bit values by adding an offset looked up by the high nibble, '/' shares the
+        // high nibble of '+' but needs a different offset.
+        const auto offsets = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+        auto isSlash = _mm_cmpeq_epi8(input, _mm_set1_epi8(0x2F));
+        auto values = _mm_add_epi8(input, _mm_shuffle_epi8(offsets, _mm_add_epi8(isSlash, highNibbles)));
+        // Pack the four 6-bit values of each 32-bit lane into 3 bytes.
+        auto merged = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+        merged = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+        merged = _mm_shuffle_epi8(merged, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(result), merged);
+        return true;
+    }
+
+    /**
+     * Encodes the data by blocks while at least 16 bytes are left, returns the number of bytes consumed.
+     */
+    SSSE3_TARGET static size_t EncodeBlocks(const char* data, size_t length, char* out) {
+        size_t sidx = 0;
+        size_t didx = 0;
+        // Each block reads 16 bytes but only consumes 12 of them.
+        while (length - sidx >= 16) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + didx), EncodeBlock(data + sidx));
+            sidx += 12;
+            didx += 16;
+        }
+        return sidx;
+    }
+
+    /**
+     * Decodes the text by blocks while at least 24 characters are left and stores the number of characters consumed.
+     * Returns false if an invalid character is found.
+     */
+    SSSE3_TARGET static bool DecodeBlocks(const char* text, size_t length, char* result, size_t* consumed) {
+        size_t sidx = 0;
+        size_t didx = 0;
+        // Each block writes 16 bytes but only produces 12 of them, stop before it could write past the result. The
+        // padding can only be in the last 4 characters, which are never decoded by a block.
+        while (length - sidx >= 24) {
+            if (!DecodeBlock(text + sidx, result + didx)) {
+                return false;
+            }
+            sidx += 16;
+            didx += 12;
+        }
+        *consumed = sidx;
+        return true;
+    }
+
+    static bool SupportsSSSE3() {
+        static const bool supported = []() {
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("ssse3") != 0;
+        }();
+        return supported;
+    }
+
+#endif
+
     size_t Base64::EncodeLength(size_t byteLength) {
         return ((byteLength + 2) / 3) * 4;
     }
 
     void Base64::Encode(const char* data, size_t length, char* out) {
-        if (!length)
-            return;
-        auto outLength = EncodeLength(length);
-
-        unsigned sidx = 0;
-        unsigned didx = 0;
-
-        if (length > 1) {
-            while (sidx < length - 2) {
-                out[didx++] = base64EncMap[(data[sidx] >> 2) & 077];
-                out[didx++] = base64EncMap[((data[sidx + 1] >> 4) & 017) | ((data[sidx] << 4) & 077)];
-                out[didx++] = base64EncMap[((data[sidx + 2] >> 6) & 003) | ((data[sidx + 1] << 2) & 077)];
-                out[didx++] = base64EncMap[data[sidx + 2] & 077];
-                sidx += 3;
-            }
+        auto bytes = reinterpret_cast<const uint8_t*>(data);
+        size_t sidx = 0;
+        size_t didx = 0;
+#ifdef BASE64_SSSE3
+        if (SupportsSSSE3()) {
+            sidx = EncodeBlocks(data, length, out);
+            didx = sidx / 3 * 4;
+        }
+#endif
+        while (length - sidx >= 3) {
+            uint32_t triple = (bytes[sidx] << 16) | (bytes[sidx + 1] << 8) | bytes[sidx + 2];
+            out[didx++] = base64EncMap[(triple >> 18) & 0x3F];
+            out[didx++] = base64EncMap[(triple >> 12) & 0x3F];
+            out[didx++] = base64EncMap[(triple >> 6) & 0x3F];
+            out[didx++] = base64EncMap[triple & 0x3F];
+            sidx += 3;
         }
-
         if (sidx < length) {
-            out[didx++] = base64EncMap[(data[sidx] >> 2) & 077];
-            if (sidx < length - 1) {
-                out[didx++] = base64EncMap[((data[sidx + 1] >> 4) & 017) | ((data[sidx] << 4) & 077)];
-                out[didx++] = base64EncMap[(data[sidx + 1] << 2) & 077];
-            } else {
-                out[didx++] = base64EncMap[(data[sidx] << 4) & 077];
+            uint32_t triple = bytes[sidx] << 16;
+            if (sidx + 1 < length) {
+                triple |= bytes[sidx + 1] << 8;
             }
-        }
-
-        while (didx < outLength) {
-            out[didx] = '=';
-            ++didx;
+            out[didx++] = base64EncMap[(triple >> 18) & 0x3F];
+            out[didx++] = base64EncMap[(triple >> 12) & 0x3F];
+            out[didx++] = sidx + 1 < length ? base64EncMap[(triple >> 6) & 0x3F] : '=';
+            out[didx++] = '=';
         }
     }
 
-    size_t Base64::DecodeLength(size_t textLength) {
-        if (!textLength || textLength % 4) {
+    size_t Base64::DecodeLength(const char* text, size_t length) {
+        if (!length || length % 4) {
             return 0;
         }
-        return textLength / 4 * 3;
+        size_t padding = 0;
+        if (text[length - 1] == '=') {
+            padding = text[length - 2] == '=' ? 2 : 1;
+        }
+        return length / 4 * 3 - padding;
     }
 
-    void Base64::Decode(const char* text, size_t length, char* result) {
-        if (!length || length % 4) {
-            return;
+    size_t Base64::Decode(const char* text, size_t length, char* result) {
+        auto byteLength = DecodeLength(text, length);
+        if (!byteLength) {
+            return 0;
+        }
+        size_t sidx = 0;
+        size_t didx = 0;
+#ifdef BASE64_SSSE3
+        if (SupportsSSSE3()) {
+            if (!DecodeBlocks(text, length, result, &sidx)) {
+                return 0;
+            }
+            didx = sidx / 4 * 3;
+        }
+#endif
+        // The last 4 characters are decoded separately since they may contain padding.
+        auto text8 = reinterpret_cast<const uint8_t*>(text);
+        while (sidx < length - 4) {
+            uint32_t a = base64DecMap[text8[sidx]];
+            uint32_t b = base64DecMap[text8[sidx + 1]];
+            uint32_t c = base64DecMap[text8[sidx + 2]];
+            uint32_t d = base64DecMap[text8[sidx + 3]];
+            if ((a | b | c | d) & 0x80) {
+                return 0;
+            }
+            uint32_t triple = (a << 18) | (b << 12) | (c << 6) | d;
+            result[didx++] = static_cast<char>(triple >> 16);
+            result[didx++] = static_cast<char>(triple >> 8);
+            result[didx++] = static_cast<char>(triple);
+            sidx += 4;
+        }
+        size_t tailLength = byteLength - didx;
+        uint32_t a = base64DecMap[text8[sidx]];
+        uint32_t b = base64DecMap[text8[sidx + 1]];
+        uint32_t c = tailLength > 1 ? base64DecMap[text8[sidx + 2]] : 0;
+        uint32_t d = tailLength > 2 ? base64DecMap[text8[sidx + 3]] : 0;
+        if ((a | b | c | d) & 0x80) {
+            return 0;
+        }
+        uint32_t triple = (a << 18) | (b << 12) | (c << 6) | d;
+        result[didx++] = static_cast<char>(triple >> 16);
+        if (tailLength > 1) {
+            result[didx++] = static_cast<char>(triple >> 8);
         }
-        auto src = text;
-        char* dest = result;
-        unsigned index = 0;
-        while (index < length) {
-            index += 4;
-            char a = base64DecMap[(unsigned char) *(src++)];
-            char b = base64DecMap[(unsigned char) *(src++)];
-            char c = base64DecMap[(unsigned char) *(src++)];
-            char d = base64DecMap[(unsigned char) *(src++)];
-            *(dest++) = (char) ((a << 2) | ((b & 0x30) >> 4));
-            if (c == (char) -1)
-                break;
-            *(dest++) = (char) (((b & 0x0f) << 4) | ((c & 0x3c) >> 2));
-            if (d == (char) -1)
-                break;
-            *(dest++) = (char) (((c & 0x03) << 6) | d);
+        if (tailLength > 2) {
+            result[didx++] = static_cast<char>(triple);
         }
+        return didx;
     }
 
-}  // namespace cyder
\ No newline at end of file
+}  // namespace cyder
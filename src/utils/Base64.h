@@ -32,6 +32,10 @@
 
 namespace cyder {
 
+    /**
+     * Base64 codec of the standard alphabet with padding. On x86, both directions are vectorized with SSSE3 when the
+     * CPU supports it at runtime, and fall back to the scalar code otherwise and for the remainders.
+     */
     class Base64 {
     public:
 
@@ -46,14 +50,16 @@ namespace cyder {
         static void Encode(const char* bytes, size_t length, char* text);
 
         /**
-         * Returns 0 if decoding encounters an error.
+         * Returns the length of the binary data encoded in the base64 string, or 0 if the length of the string is not
+         * a multiple of 4.
          */
-        static size_t DecodeLength(size_t textLength);
+        static size_t DecodeLength(const char* text, size_t length);
 
         /**
-         * Converts the base64 string to binary data.
+         * Converts the base64 string to binary data, the result must have room for DecodeLength() bytes. Returns the
+         * number of bytes written, or 0 if the string is not valid base64.
          */
-        static void Decode(const char* text, size_t length, char* result);
+        static size_t Decode(const char* text, size_t length, char* result);
 
     };
 
@@ -0,0 +1,88 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017-present, cyder.org
+//  All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in the
+//  Software without restriction, including without limitation the rights to use, copy,
+//  modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//  and to permit persons to whom the Software is furnished to do so, subject to the
+//  following conditions:
+//
+//      The above copyright notice and this permission notice shall be included in all
+//      copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED *AS IS*, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//  PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "Base64DecodeStream.h"
+#include <algorithm>
+#include <cstring>
+#include "Base64.h"
+
+namespace cyder {
+
+    Base64DecodeStream* Base64DecodeStream::Make(std::string text) {
+        auto length = Base64::DecodeLength(text.data(), text.size());
+        if (!length) {
+            return nullptr;
+        }
+        return new Base64DecodeStream(std::make_shared<const std::string>(std::move(text)), length);
+    }
+
+    Base64DecodeStream::Base64DecodeStream(std::shared_ptr<const std::string> text, size_t length) :
+            text(std::move(text)), length(length) {
+    }
+
+    size_t Base64DecodeStream::read(void* buffer, size_t size) {
+        size = std::min(size, length - position);
+        if (!buffer) {
+            position += size;
+            return size;
+        }
+        auto output = static_cast<char*>(buffer);
+        auto input = text->data();
+        size_t done = 0;
+        while (done < size) {
+            // Every 4 characters encode 3 bytes.
+            size_t group = position / 3;
+            size_t offset = position % 3;
+            size_t groupCount = (size - done) / 3;
+            if (offset == 0 && groupCount > 0) {
+                // Decode the whole groups straight into the buffer.
+                auto decoded = Base64::Decode(input + group * 4, groupCount * 4, output + done);
+                if (!decoded) {
+                    // The text is corrupted, end the stream here.
+                    length = position;
+                    break;
+                }
+                done += decoded;
+                position += decoded;
+                continue;
+            }
+            // The read starts or ends in the middle of a group, decode it to a temporary buffer.
+            char bytes[3];
+            auto decoded = Base64::Decode(input + group * 4, 4, bytes);
+            if (decoded <= offset) {
+                length = position;
+                break;
+            }
+            auto count = std::min(decoded - offset, size - done);
+            memcpy(output + done, bytes + offset, count);
+            done += count;
+            position += count;
+        }
+        return done;
+    }
+
+}
@@ -0,0 +1,95 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017-present, cyder.org
+//  All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in the
+//  Software without restriction, including without limitation the rights to use, copy,
+//  modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//  and to permit persons to whom the Software is furnished to do so, subject to the
+//  following conditions:
+//
+//      The above copyright notice and this permission notice shall be included in all
+//      copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED *AS IS*, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//  PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CYDER_BASE64DECODESTREAM_H
+#define CYDER_BASE64DECODESTREAM_H
+
+#include <memory>
+#include <string>
+#include <skia.h>
+
+namespace cyder {
+
+    /**
+     * A stream of the binary data encoded in a base64 string. The data is decoded on demand while it is read, so a
+     * codec can read an image from a data URL without the decoded bytes ever being stored as a whole.
+     */
+    class Base64DecodeStream : public SkStreamRewindable {
+    public:
+        /**
+         * Creates a stream of the base64 string, returns nullptr if the length of the string is not valid.
+         */
+        static Base64DecodeStream* Make(std::string text);
+
+        /**
+         * Reads the decoded bytes into the buffer, or skips them if the buffer is nullptr. Reading stops at the first
+         * invalid base64 character.
+         */
+        size_t read(void* buffer, size_t size) override;
+
+        bool isAtEnd() const override {
+            return position >= length;
+        }
+
+        bool rewind() override {
+            position = 0;
+            return true;
+        }
+
+        SkStreamRewindable* duplicate() const override {
+            return new Base64DecodeStream(text, length);
+        }
+
+        bool hasPosition() const override {
+            return true;
+        }
+
+        size_t getPosition() const override {
+            return position;
+        }
+
+        bool hasLength() const override {
+            return true;
+        }
+
+        size_t getLength() const override {
+            return length;
+        }
+
+    private:
+        Base64DecodeStream(std::shared_ptr<const std::string> text, size_t length);
+
+        /**
+         * The text is shared with the duplicates of the stream.
+         */
+        std::shared_ptr<const std::string> text;
+        size_t length;
+        size_t position = 0;
+    };
+
+}
+
+#endif //CYDER_BASE64DECODESTREAM_H
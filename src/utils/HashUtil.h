@@ -0,0 +1,83 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017-present, cyder.org
+//  All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in the
+//  Software without restriction, including without limitation the rights to use, copy,
+//  modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//  and to permit persons to whom the Software is furnished to do so, subject to the
+//  following conditions:
+//
+//      The above copyright notice and this permission notice shall be included in all
+//      copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED *AS IS*, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//  PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CYDER_HASHUTIL_H
+#define CYDER_HASHUTIL_H
+
+#include <cstdint>
+#include <cstring>
+
+namespace cyder {
+
+    class HashUtil {
+    public:
+        /**
+         * Returns a 64-bit hash of the bytes (MurmurHash64A). It is fast enough to hash the contents of large files,
+         * but is not a cryptographic hash.
+         */
+        static uint64_t Hash64(const void* data, size_t length, uint64_t seed = 0) {
+            const uint64_t m = 0xc6a4a7935bd1e995ULL;
+            const int r = 47;
+            uint64_t h = seed ^ (length * m);
+            auto bytes = static_cast<const uint8_t*>(data);
+            auto end = bytes + (length & ~static_cast<size_t>(7));
+            for (; bytes != end; bytes += 8) {
+                uint64_t k;
+                memcpy(&k, bytes, sizeof(k));
+                k *= m;
+                k ^= k >> r;
+                k *= m;
+                h ^= k;
+                h *= m;
+            }
+            switch (length & 7) {
+                case 7:
+                    h ^= static_cast<uint64_t>(bytes[6]) << 48;
+                case 6:
+                    h ^= static_cast<uint64_t>(bytes[5]) << 40;
+                case 5:
+                    h ^= static_cast<uint64_t>(bytes[4]) << 32;
+                case 4:
+                    h ^= static_cast<uint64_t>(bytes[3]) << 24;
+                case 3:
+                    h ^= static_cast<uint64_t>(bytes[2]) << 16;
+                case 2:
+                    h ^= static_cast<uint64_t>(bytes[1]) << 8;
+                case 1:
+                    h ^= static_cast<uint64_t>(bytes[0]);
+                    h *= m;
+                default:
+                    break;
+            }
+            h ^= h >> r;
+            h *= m;
+            h ^= h >> r;
+            return h;
+        }
+    };
+}
+
+#endif //CYDER_HASHUTIL_H
@@ -0,0 +1,163 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017-present, cyder.org
+//  All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in the
+//  Software without restriction, including without limitation the rights to use, copy,
+//  modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//  and to permit persons to whom the Software is furnished to do so, subject to the
+//  following conditions:
+//
+//      The above copyright notice and this permission notice shall be included in all
+//      copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED *AS IS*, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//  PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "PixelConverter.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PIXEL_CONVERTER_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace cyder {
+
+    // The pixels are handled as little-endian 32-bit words, byte 0 is the lowest 8 bits.
+
+    static inline uint32_t UnpremultiplyPixel(uint32_t pixel, bool swapRB) {
+        uint32_t a = pixel >> 24;
+        uint32_t c0 = pixel & 0xFF;
+        uint32_t c1 = (pixel >> 8) & 0xFF;
+        uint32_t c2 = (pixel >> 16) & 0xFF;
+        if (a == 0) {
+            return 0;
+        }
+        if (a != 255) {
+            // Same arithmetic as the vectorized version so that both produce identical results.
+            float scale = 255.0f / a;
+            c0 = static_cast<uint32_t>(c0 * scale + 0.5f);
+            c1 = static_cast<uint32_t>(c1 * scale + 0.5f);
+            c2 = static_cast<uint32_t>(c2 * scale + 0.5f);
+            c0 = c0 > 255 ? 255 : c0;
+            c1 = c1 > 255 ? 255 : c1;
+            c2 = c2 > 255 ? 255 : c2;
+        }
+        if (swapRB) {
+            return c2 | (c1 << 8) | (c0 << 16) | (a << 24);
+        }
+        return c0 | (c1 << 8) | (c2 << 16) | (a << 24);
+    }
+
+    static inline uint32_t MulDiv255Round(uint32_t value, uint32_t alpha) {
+        auto product = value * alpha + 128;
+        return (product + (product >> 8)) >> 8;
+    }
+
+    static inline uint32_t PremultiplyPixel(uint32_t pixel, bool swapRB) {
+        uint32_t a = pixel >> 24;
+        uint32_t r = pixel & 0xFF;
+        uint32_t g = (pixel >> 8) & 0xFF;
+        uint32_t b = (pixel >> 16) & 0xFF;
+        if (a != 255) {
+            r = MulDiv255Round(r, a);
+            g = MulDiv255Round(g, a);
+            b = MulDiv255Round(b, a);
+        }
+        if (swapRB) {
+            return b | (g << 8) | (r << 16) | (a << 24);
+        }
+        return r | (g << 8) | (b << 16) | (a << 24);
+    }
+
+#ifdef PIXEL_CONVERTER_SSE2
+
+    /**
+     * Packs four channels of four pixels, each channel in the low 8 bits of a 32-bit lane, back into four pixels.
+     */
+    static inline __m128i PackChannels(__m128i c0, __m128i c1, __m128i c2, __m128i a) {
+        return _mm_or_si128(_mm_or_si128(c0, _mm_slli_epi32(c1, 8)),
+                            _mm_or_si128(_mm_slli_epi32(c2, 16), _mm_slli_epi32(a, 24)));
+    }
+
+    void PixelConverter::Unpremultiply(const uint32_t* src, uint32_t* dst, int count, bool swapRB) {
+        const __m128i mask = _mm_set1_epi32(0xFF);
+        const __m128 half = _mm_set1_ps(0.5f);
+        const __m128 max = _mm_set1_ps(255.0f);
+        const __m128 zero = _mm_setzero_ps();
+        int i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            __m128i a = _mm_srli_epi32(pixels, 24);
+            __m128 alpha = _mm_cvtepi32_ps(a);
+            // The scale is 255 / alpha, or 0 for fully transparent pixels instead of infinity.
+            __m128 scale = _mm_and_ps(_mm_div_ps(max, alpha), _mm_cmpneq_ps(alpha, zero));
+            __m128 c0 = _mm_cvtepi32_ps(_mm_and_si128(pixels, mask));
+            __m128 c1 = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(pixels, 8), mask));
+            __m128 c2 = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(pixels, 16), mask));
+            __m128i r0 = _mm_cvttps_epi32(_mm_min_ps(_mm_add_ps(_mm_mul_ps(c0, scale), half), max));
+            __m128i r1 = _mm_cvttps_epi32(_mm_min_ps(_mm_add_ps(_mm_mul_ps(c1, scale), half), max));
+            __m128i r2 = _mm_cvttps_epi32(_mm_min_ps(_mm_add_ps(_mm_mul_ps(c2, scale), half), max));
+            __m128i result = swapRB ? PackChannels(r2, r1, r0, a) : PackChannels(r0, r1, r2, a);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), result);
+        }
+        for (; i < count; i++) {
+            dst[i] = UnpremultiplyPixel(src[i], swapRB);
+        }
+    }
+
+    /**
+     * Computes value * alpha / 255 rounded to the nearest integer for each 32-bit lane, the inputs must be in the range
+     * 0 to 255.
+     */
+    static inline __m128i MulDiv255Round(__m128i value, __m128i alpha) {
+        // The product fits in 16 bits, so the 16-bit multiplication gives the exact result in each 32-bit lane.
+        __m128i product = _mm_add_epi32(_mm_mullo_epi16(value, alpha), _mm_set1_epi32(128));
+        return _mm_srli_epi32(_mm_add_epi32(product, _mm_srli_epi32(product, 8)), 8);
+    }
+
+    void PixelConverter::Premultiply(const uint32_t* src, uint32_t* dst, int count, bool swapRB) {
+        const __m128i mask = _mm_set1_epi32(0xFF);
+        int i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            __m128i a = _mm_srli_epi32(pixels, 24);
+            __m128i r = MulDiv255Round(_mm_and_si128(pixels, mask), a);
+            __m128i g = MulDiv255Round(_mm_and_si128(_mm_srli_epi32(pixels, 8), mask), a);
+            __m128i b = MulDiv255Round(_mm_and_si128(_mm_srli_epi32(pixels, 16), mask), a);
+            __m128i result = swapRB ? PackChannels(b, g, r, a) : PackChannels(r, g, b, a);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), result);
+        }
+        for (; i < count; i++) {
+            dst[i] = PremultiplyPixel(src[i], swapRB);
+        }
+    }
+
+#else
+
+    void PixelConverter::Unpremultiply(const uint32_t* src, uint32_t* dst, int count, bool swapRB) {
+        for (int i = 0; i < count; i++) {
+            dst[i] = UnpremultiplyPixel(src[i], swapRB);
+        }
+    }
+
+    void PixelConverter::Premultiply(const uint32_t* src, uint32_t* dst, int count, bool swapRB) {
+        for (int i = 0; i < count; i++) {
+            dst[i] = PremultiplyPixel(src[i], swapRB);
+        }
+    }
+
+#endif
+
+}
@@ -0,0 +1,62 @@
+//////////////////////////////////////////////////////////////////////////////////////
+//
+//  The MIT License (MIT)
+//
+//  Copyright (c) 2017-present, cyder.org
+//  All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in the
+//  Software without restriction, including without limitation the rights to use, copy,
+//  modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//  and to permit persons to whom the Software is furnished to do so, subject to the
+//  following conditions:
+//
+//      The above copyright notice and this permission notice shall be included in all
+//      copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED *AS IS*, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//  PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//  HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef CYDER_PIXELCONVERTER_H
+#define CYDER_PIXELCONVERTER_H
+
+#include <cstdint>
+
+namespace cyder {
+
+    /**
+     * Converts pixels between the premultiplied 32-bit format of the drawing buffers and the unpremultiplied RGBA format
+     * of ImageData. The conversions are vectorized with SSE2 where it is available.
+     */
+    class PixelConverter {
+    public:
+        /**
+         * Converts premultiplied pixels into unpremultiplied RGBA pixels.
+         * @param src The source pixels, in RGBA order or in BGRA order if swapRB is true.
+         * @param dst The destination RGBA pixels, it may be the same as src.
+         * @param count The number of pixels to convert.
+         * @param swapRB Whether the source pixels are in BGRA order.
+         */
+        static void Unpremultiply(const uint32_t* src, uint32_t* dst, int count, bool swapRB);
+
+        /**
+         * Converts unpremultiplied RGBA pixels into premultiplied pixels.
+         * @param src The source RGBA pixels.
+         * @param dst The destination pixels, in RGBA order or in BGRA order if swapRB is true. It may be the same as src.
+         * @param count The number of pixels to convert.
+         * @param swapRB Whether the destination pixels are in BGRA order.
+         */
+        static void Premultiply(const uint32_t* src, uint32_t* dst, int count, bool swapRB);
+    };
+
+}
+
+#endif //CYDER_PIXELCONVERTER_H